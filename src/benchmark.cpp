@@ -0,0 +1,98 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace benchmark {
+
+using namespace std::literals;
+using namespace graph;
+using transport_catalogue::router::SearchTime;
+
+namespace {
+
+const size_t TREE_COUNT = 200;
+const size_t ROUTE_COUNT = 2000;
+const unsigned SEED = 42;
+
+struct Queries {
+  std::vector<VertexId> sources;
+  std::vector<std::pair<VertexId, VertexId>> routes;
+};
+
+Queries MakeQueries(size_t vertex_count) {
+  Queries queries;
+  if (vertex_count == 0) {
+    return queries;
+  }
+
+  const size_t tree_count = std::min(TREE_COUNT, vertex_count);
+  for (size_t i = 0; i < tree_count; ++i) {
+    queries.sources.push_back(i * vertex_count / tree_count);
+  }
+
+  std::mt19937 generator(SEED);
+  std::uniform_int_distribution<VertexId> vertices(0, vertex_count - 1);
+  for (size_t i = 0; i < ROUTE_COUNT; ++i) {
+    queries.routes.emplace_back(vertices(generator), vertices(generator));
+  }
+
+  return queries;
+}
+
+double GetMilliseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename QueuePolicy>
+void RunSearches(std::string_view name, const CsrGraph<SearchTime> &graph,
+                 const Queries &queries, std::ostream &out) {
+  const DijkstraRouter<SearchTime, QueuePolicy> router(graph);
+  uint64_t checksum = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (const VertexId source : queries.sources) {
+    const auto routes_tree = router.BuildRoutesTree(source);
+    for (const auto &[from, to] : queries.routes) {
+      if (const auto weight = routes_tree.GetWeight(to)) {
+        checksum += weight->GetValue();
+      }
+    }
+  }
+  const double trees_time = GetMilliseconds(start);
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &[from, to] : queries.routes) {
+    if (const auto route = router.BuildRoute(from, to)) {
+      checksum += route->weight.GetValue();
+    }
+  }
+  const double routes_time = GetMilliseconds(start);
+
+  out << name << ": "sv << queries.sources.size() << " trees "sv
+      << trees_time << " ms, "sv << queries.routes.size() << " routes "sv
+      << routes_time << " ms, checksum "sv << checksum << '\n';
+}
+
+}  // namespace
+
+void QueueBenchmark(
+    const transport_catalogue::router::TransportRouter &transport_router,
+    std::ostream &out) {
+  const CsrGraph<SearchTime> graph(transport_router.GetGraph());
+  const Queries queries = MakeQueries(graph.GetVertexCount());
+
+  out << "vertices "sv << graph.GetVertexCount() << ", edges "sv
+      << graph.GetEdgeCount() << '\n';
+  RunSearches<BinaryHeapPolicy>("binary heap"sv, graph, queries, out);
+  RunSearches<QuaternaryHeapPolicy>("4-ary heap"sv, graph, queries, out);
+  RunSearches<RadixHeapPolicy>("radix heap"sv, graph, queries, out);
+}
+
+}  // namespace benchmark
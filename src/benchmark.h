@@ -0,0 +1,17 @@
+#pragma once
+
+#include <iostream>
+
+#include "router.h"
+
+namespace benchmark {
+
+// Times single-source searches over the routing graph with every priority
+// queue policy: full search trees from a spread of sources and searches
+// between random pairs of vertices. Equal checksums mean the searches found
+// routes of equal weights.
+void QueueBenchmark(
+    const transport_catalogue::router::TransportRouter &transport_router,
+    std::ostream &out);
+
+}  // namespace benchmark
@@ -37,6 +37,44 @@ void TransportCatalogue::AddDistance(const std::vector<Distance> &distances) {
   }
 }
 
+void TransportCatalogue::SetDistance(const std::vector<Distance> &distances) {
+  std::unordered_set<Bus *> changed_buses;
+
+  for (const auto &tmp_distance : distances) {
+    LOG(DEBUG) << "Set distance between " << tmp_distance.start->name
+               << " and " << tmp_distance.end->name << " to "
+               << tmp_distance.distance;
+    distances_to_stop.insert_or_assign(
+        std::make_pair(tmp_distance.start, tmp_distance.end),
+        tmp_distance.distance);
+    // A distance is also used in the opposite direction when that one is
+    // unknown, so buses through either stop may change.
+    changed_buses.insert(tmp_distance.start->buses.begin(),
+                         tmp_distance.start->buses.end());
+    changed_buses.insert(tmp_distance.end->buses.begin(),
+                         tmp_distance.end->buses.end());
+  }
+
+  for (Bus *bus : changed_buses) {
+    bus->route_length = GetDistanceBuses(bus);
+  }
+}
+
+void TransportCatalogue::RemoveBus(Bus *bus) {
+  LOG(DEBUG) << "Remove bus " << bus->name;
+  buses_to_bus.erase(bus->name);
+
+  for (Stop *stop : bus->stops) {
+    stop->buses.erase(
+        std::remove(stop->buses.begin(), stop->buses.end(), bus),
+        stop->buses.end());
+  }
+
+  const auto it = std::find_if(buses.begin(), buses.end(),
+                               [bus](const Bus &tmp) { return &tmp == bus; });
+  removed_buses.splice(removed_buses.end(), buses, it);
+}
+
 Bus *TransportCatalogue::GetBus(std::string_view name) {
   LOG(DEBUG) << "Get bus " << name;
   return buses_to_bus.empty() || !buses_to_bus.count(name)
@@ -51,8 +89,8 @@ Stop *TransportCatalogue::GetStop(std::string_view stop_name) {
              : stops_to_stop.at(stop_name);
 }
 
-std::deque<Stop> TransportCatalogue::GetStops() const { return stops; }
-std::deque<Bus> TransportCatalogue::GetBuses() const { return buses; }
+const std::deque<Stop> &TransportCatalogue::GetStops() const { return stops; }
+const std::list<Bus> &TransportCatalogue::GetBuses() const { return buses; }
 BusesMap TransportCatalogue::GetBusNames() const { return buses_to_bus; }
 StopsMap TransportCatalogue::GetStopNames() const { return stops_to_stop; }
 
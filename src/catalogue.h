@@ -2,6 +2,7 @@
 #include <deque>
 #include <iomanip>
 #include <iostream>
+#include <list>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -35,11 +36,15 @@ class TransportCatalogue {
   void AddBus(Bus &&bus);
   void AddStop(Stop &&stop);
   void AddDistance(const std::vector<Distance> &distances);
+  // Overwrites known distances and recounts the route lengths of the buses
+  // through their stops.
+  void SetDistance(const std::vector<Distance> &distances);
+  void RemoveBus(Bus *bus);
 
   Bus *GetBus(std::string_view name);
   Stop *GetStop(std::string_view stop_name);
-  std::deque<Stop> GetStops() const;
-  std::deque<Bus> GetBuses() const;
+  const std::deque<Stop> &GetStops() const;
+  const std::list<Bus> &GetBuses() const;
   BusesMap GetBusNames() const;
   StopsMap GetStopNames() const;
   std::unordered_set<const Bus *> GetUniqueBuses(Stop *stop);
@@ -51,7 +56,9 @@ class TransportCatalogue {
 
  private:
   std::deque<Stop> stops;
-  std::deque<Bus> buses;
+  std::list<Bus> buses;
+  // Removed buses are kept, a router may still refer to their names.
+  std::list<Bus> removed_buses;
   StopsMap stops_to_stop;
   BusesMap buses_to_bus;
   DistancesMap distances_to_stop;
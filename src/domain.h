@@ -28,6 +28,9 @@ struct StatisticRequest {
   std::string name;
   std::string from;
   std::string to;
+  std::vector<std::string> from_stops;
+  std::vector<std::string> to_stops;
+  double max_time = 0;
 };
 
 struct Stop {
@@ -76,9 +79,27 @@ struct BusEdge {
   double time = 0;
 };
 
+enum class RouterType {
+  DIJKSTRA,
+  ALL_PAIRS,
+  CONTRACTION_HIERARCHIES,
+  ASTAR,
+  HUB_LABELS,
+  ALT
+};
+
+enum class GraphModel { STOP_PAIRS, BUS_RIDES, STOP_VERTICES };
+
+enum class AllPairsAlgorithm { FLOYD_WARSHALL, DIJKSTRA };
+
 struct RoutingSettings {
   double bus_wait_time = 0;
   double bus_velocity = 0;
+  RouterType router_type = RouterType::DIJKSTRA;
+  GraphModel graph_model = GraphModel::STOP_PAIRS;
+  AllPairsAlgorithm all_pairs_algorithm = AllPairsAlgorithm::DIJKSTRA;
+  size_t landmark_count = 16;
+  bool compact_graph = false;
 };
 
 struct RouterStop {
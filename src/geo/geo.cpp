@@ -1,5 +1,8 @@
 #include "geo.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "../log/easylogging++.h"
 
 namespace geo {
@@ -18,4 +21,50 @@ double CalculateDistance(Coordinates from, Coordinates to) {
          R;
 }
 
+CartesianPoint ToCartesian(Coordinates coordinates) {
+  using namespace std;
+  return {R * cos(coordinates.latitude * dr) * cos(coordinates.longitude * dr),
+          R * cos(coordinates.latitude * dr) * sin(coordinates.longitude * dr),
+          R * sin(coordinates.latitude * dr)};
+}
+
+double CalculateChordDistance(CartesianPoint from, CartesianPoint to) {
+  const double dx = from.x - to.x;
+  const double dy = from.y - to.y;
+  const double dz = from.z - to.z;
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+uint64_t GetHilbertIndex(Coordinates coordinates) {
+  // The map is a grid of 2^32 x 2^32 cells.
+  constexpr uint64_t SIDE = uint64_t{1} << 32;
+  auto to_cell = [](double value, double min, double max) {
+    const double cell = std::floor((value - min) / (max - min) * SIDE);
+    return static_cast<uint64_t>(
+        std::clamp(cell, 0., static_cast<double>(SIDE - 1)));
+  };
+
+  uint64_t x = to_cell(coordinates.longitude, -180., 180.);
+  uint64_t y = to_cell(coordinates.latitude, -90., 90.);
+  uint64_t index = 0;
+
+  for (uint64_t side = SIDE / 2; side > 0; side /= 2) {
+    const uint64_t rx = (x & side) ? 1 : 0;
+    const uint64_t ry = (y & side) ? 1 : 0;
+    index += side * side * ((3 * rx) ^ ry);
+
+    // Rotates the quadrant so that the curve inside it starts where the
+    // curve enters the quadrant.
+    if (ry == 0) {
+      if (rx == 1) {
+        x = SIDE - 1 - x;
+        y = SIDE - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+
+  return index;
+}
+
 }  // namespace geo
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 
 namespace geo {
 
@@ -15,6 +16,24 @@ struct Coordinates {
   bool operator!=(const Coordinates& other) const { return !(*this == other); }
 };
 
+struct CartesianPoint {
+  double x{0.};
+  double y{0.};
+  double z{0.};
+};
+
 double CalculateDistance(Coordinates from, Coordinates to);
 
+// Point on the Earth's surface in metres from the centre of the Earth.
+CartesianPoint ToCartesian(Coordinates coordinates);
+
+// Straight line distance through the Earth. It is never greater than
+// CalculateDistance and cheap to compute for cached CartesianPoints.
+double CalculateChordDistance(CartesianPoint from, CartesianPoint to);
+
+// Position of the point on a Hilbert curve over the whole map. Points close
+// on the curve are close on the map, so sorting by it keeps neighbours
+// together.
+uint64_t GetHilbertIndex(Coordinates coordinates);
+
 }  // namespace geo
\ No newline at end of file
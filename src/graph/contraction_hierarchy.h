@@ -0,0 +1,466 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "heap.h"
+
+namespace graph {
+
+// Vertices are contracted one by one in the order of their rank. Contracting a
+// vertex adds shortcuts between its remaining neighbours for every shortest
+// path that goes through it, so a route query only has to search upwards in
+// rank from both ends.
+template <typename Weight>
+class ContractionHierarchy {
+  using Graph = DirectedWeightedGraph<Weight>;
+
+ public:
+  static constexpr EdgeId NO_EDGE = std::numeric_limits<EdgeId>::max();
+
+  // Either an edge of the original graph or a shortcut replacing the pair of
+  // hierarchy edges first and second.
+  struct HierarchyEdge {
+    VertexId from;
+    VertexId to;
+    Weight weight;
+    EdgeId edge = NO_EDGE;
+    EdgeId first = NO_EDGE;
+    EdgeId second = NO_EDGE;
+  };
+
+  explicit ContractionHierarchy(const Graph& graph);
+  ContractionHierarchy(std::vector<size_t> ranks,
+                       std::vector<HierarchyEdge> edges);
+
+  struct RouteInfo {
+    Weight weight;
+    std::vector<EdgeId> edges;
+  };
+
+  std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+
+  const std::vector<size_t>& GetRanks() const;
+  const std::vector<HierarchyEdge>& GetEdges() const;
+
+ private:
+  static constexpr size_t WITNESS_SETTLED_LIMIT = 500;
+
+  struct QueueItem {
+    Weight weight;
+    VertexId vertex;
+
+    bool operator<(const QueueItem& other) const {
+      return weight < other.weight;
+    }
+  };
+
+  struct SearchDirection {
+    std::vector<Weight> weights;
+    std::vector<EdgeId> prev_edges;
+    std::vector<uint32_t> reached;
+    std::vector<uint32_t> settled;
+    DaryHeap<QueueItem, 4> queue;
+
+    void Reset(size_t vertex_count, bool clear) {
+      if (weights.size() < vertex_count) {
+        weights.resize(vertex_count);
+        prev_edges.resize(vertex_count);
+        reached.resize(vertex_count, 0);
+        settled.resize(vertex_count, 0);
+      }
+
+      if (clear) {
+        std::fill(reached.begin(), reached.end(), 0);
+        std::fill(settled.begin(), settled.end(), 0);
+      }
+
+      queue.Clear();
+    }
+
+    bool Reached(VertexId vertex, uint32_t stamp) const {
+      return reached[vertex] == stamp;
+    }
+
+    void Push(VertexId vertex, Weight weight, EdgeId prev_edge,
+              uint32_t stamp) {
+      if (reached[vertex] != stamp || weight < weights[vertex]) {
+        reached[vertex] = stamp;
+        weights[vertex] = weight;
+        prev_edges[vertex] = prev_edge;
+        queue.Push({weight, vertex});
+      }
+    }
+  };
+
+  // Scratch space of the searches of a thread, see DijkstraRouter.
+  struct SearchSpace {
+    SearchDirection forward;
+    SearchDirection backward;
+    uint32_t stamp = 0;
+
+    void Reset(size_t vertex_count) {
+      const bool clear = ++stamp == 0;
+      if (clear) {
+        stamp = 1;
+      }
+      forward.Reset(vertex_count, clear);
+      backward.Reset(vertex_count, clear);
+    }
+  };
+
+  struct Link {
+    VertexId vertex;
+    EdgeId edge;
+  };
+
+  struct Contraction {
+    std::vector<std::vector<Link>> out;
+    std::vector<std::vector<Link>> in;
+    std::vector<size_t> contracted_neighbours;
+    SearchSpace witness;
+  };
+
+  static SearchSpace& GetSearchSpace() {
+    thread_local SearchSpace search_space;
+    return search_space;
+  }
+
+  void AddLink(Contraction& contraction, HierarchyEdge edge);
+  size_t ContractVertex(Contraction& contraction, VertexId vertex,
+                        bool simulate);
+  int GetPriority(Contraction& contraction, VertexId vertex);
+  void BuildSearchGraphs();
+  void UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& edges) const;
+
+  static constexpr Weight ZERO_WEIGHT{};
+  std::vector<size_t> ranks_;
+  std::vector<HierarchyEdge> edges_;
+  std::vector<std::vector<EdgeId>> upward_edges_;
+  std::vector<std::vector<EdgeId>> downward_edges_;
+};
+
+template <typename Weight>
+ContractionHierarchy<Weight>::ContractionHierarchy(const Graph& graph)
+    : ranks_(graph.GetVertexCount()) {
+  const size_t vertex_count = graph.GetVertexCount();
+
+  Contraction contraction;
+  contraction.out.resize(vertex_count);
+  contraction.in.resize(vertex_count);
+  contraction.contracted_neighbours.resize(vertex_count, 0);
+
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+      const auto& edge = graph.GetEdge(edge_id);
+
+      if (edge.weight < ZERO_WEIGHT) {
+        throw std::domain_error("Edges' weights should be non-negative");
+      }
+
+      AddLink(contraction, {edge.from, edge.to, edge.weight, edge_id});
+    }
+  }
+
+  DaryHeap<std::pair<int, VertexId>, 4> queue;
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    queue.Push({GetPriority(contraction, vertex), vertex});
+  }
+
+  size_t rank = 0;
+  while (!queue.Empty()) {
+    const VertexId vertex = queue.Pop().second;
+    const int priority = GetPriority(contraction, vertex);
+
+    if (!queue.Empty() && priority > queue.Top().first) {
+      queue.Push({priority, vertex});
+      continue;
+    }
+
+    ContractVertex(contraction, vertex, false);
+    ranks_[vertex] = rank++;
+  }
+
+  BuildSearchGraphs();
+}
+
+template <typename Weight>
+ContractionHierarchy<Weight>::ContractionHierarchy(
+    std::vector<size_t> ranks, std::vector<HierarchyEdge> edges)
+    : ranks_(std::move(ranks)), edges_(std::move(edges)) {
+  for (const auto& edge : edges_) {
+    if (edge.from >= ranks_.size() || edge.to >= ranks_.size()) {
+      throw std::invalid_argument("Hierarchy edge does not match the graph");
+    }
+  }
+
+  BuildSearchGraphs();
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::AddLink(Contraction& contraction,
+                                           HierarchyEdge edge) {
+  if (edge.from == edge.to) {
+    return;
+  }
+
+  auto& out = contraction.out[edge.from];
+  const auto it = std::find_if(out.begin(), out.end(), [&edge](Link link) {
+    return link.vertex == edge.to;
+  });
+
+  if (it != out.end() && !(edge.weight < edges_[it->edge].weight)) {
+    return;
+  }
+
+  const VertexId from = edge.from;
+  const VertexId to = edge.to;
+  edges_.push_back(std::move(edge));
+  const EdgeId edge_id = edges_.size() - 1;
+
+  if (it != out.end()) {
+    it->edge = edge_id;
+    for (auto& link : contraction.in[to]) {
+      if (link.vertex == from) {
+        link.edge = edge_id;
+      }
+    }
+  } else {
+    out.push_back({to, edge_id});
+    contraction.in[to].push_back({from, edge_id});
+  }
+}
+
+template <typename Weight>
+size_t ContractionHierarchy<Weight>::ContractVertex(Contraction& contraction,
+                                                    VertexId vertex,
+                                                    bool simulate) {
+  const auto& in = contraction.in[vertex];
+  const auto& out = contraction.out[vertex];
+  SearchDirection& witness = contraction.witness.forward;
+  size_t shortcut_count = 0;
+
+  Weight max_out_weight = ZERO_WEIGHT;
+  for (const Link link : out) {
+    max_out_weight = std::max(max_out_weight, edges_[link.edge].weight);
+  }
+
+  for (const Link in_link : in) {
+    const Weight in_weight = edges_[in_link.edge].weight;
+    const Weight max_weight = in_weight + max_out_weight;
+
+    contraction.witness.Reset(ranks_.size());
+    const uint32_t stamp = contraction.witness.stamp;
+    witness.Push(in_link.vertex, ZERO_WEIGHT, NO_EDGE, stamp);
+
+    size_t settled_count = 0;
+    while (!witness.queue.Empty() && settled_count < WITNESS_SETTLED_LIMIT) {
+      const auto [weight, current] = witness.queue.Pop();
+      if (witness.settled[current] == stamp) {
+        continue;
+      }
+      witness.settled[current] = stamp;
+      ++settled_count;
+
+      if (max_weight < weight) {
+        break;
+      }
+
+      for (const Link link : contraction.out[current]) {
+        if (link.vertex != vertex) {
+          witness.Push(link.vertex, weight + edges_[link.edge].weight, NO_EDGE,
+                       stamp);
+        }
+      }
+    }
+
+    for (const Link out_link : out) {
+      if (out_link.vertex == in_link.vertex) {
+        continue;
+      }
+
+      const Weight weight = in_weight + edges_[out_link.edge].weight;
+      if (witness.Reached(out_link.vertex, stamp) &&
+          !(weight < witness.weights[out_link.vertex])) {
+        continue;
+      }
+
+      ++shortcut_count;
+      if (!simulate) {
+        AddLink(contraction, {in_link.vertex, out_link.vertex, weight, NO_EDGE,
+                              in_link.edge, out_link.edge});
+      }
+    }
+  }
+
+  if (!simulate) {
+    for (const Link link : contraction.in[vertex]) {
+      auto& neighbour_out = contraction.out[link.vertex];
+      neighbour_out.erase(
+          std::remove_if(neighbour_out.begin(), neighbour_out.end(),
+                         [vertex](Link l) { return l.vertex == vertex; }),
+          neighbour_out.end());
+      ++contraction.contracted_neighbours[link.vertex];
+    }
+
+    for (const Link link : contraction.out[vertex]) {
+      auto& neighbour_in = contraction.in[link.vertex];
+      neighbour_in.erase(
+          std::remove_if(neighbour_in.begin(), neighbour_in.end(),
+                         [vertex](Link l) { return l.vertex == vertex; }),
+          neighbour_in.end());
+      ++contraction.contracted_neighbours[link.vertex];
+    }
+
+    contraction.in[vertex].clear();
+    contraction.out[vertex].clear();
+  }
+
+  return shortcut_count;
+}
+
+template <typename Weight>
+int ContractionHierarchy<Weight>::GetPriority(Contraction& contraction,
+                                              VertexId vertex) {
+  const int shortcut_count =
+      static_cast<int>(ContractVertex(contraction, vertex, true));
+  const int degree = static_cast<int>(contraction.in[vertex].size() +
+                                      contraction.out[vertex].size());
+
+  return shortcut_count - degree +
+         static_cast<int>(contraction.contracted_neighbours[vertex]);
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::BuildSearchGraphs() {
+  upward_edges_.assign(ranks_.size(), {});
+  downward_edges_.assign(ranks_.size(), {});
+
+  for (EdgeId edge_id = 0; edge_id < edges_.size(); ++edge_id) {
+    const auto& edge = edges_[edge_id];
+
+    if (ranks_[edge.from] < ranks_[edge.to]) {
+      upward_edges_[edge.from].push_back(edge_id);
+    } else {
+      downward_edges_[edge.to].push_back(edge_id);
+    }
+  }
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::UnpackEdge(
+    EdgeId edge_id, std::vector<EdgeId>& edges) const {
+  std::vector<EdgeId> stack{edge_id};
+
+  while (!stack.empty()) {
+    const auto& edge = edges_[stack.back()];
+    stack.pop_back();
+
+    if (edge.edge != NO_EDGE) {
+      edges.push_back(edge.edge);
+    } else {
+      stack.push_back(edge.second);
+      stack.push_back(edge.first);
+    }
+  }
+}
+
+template <typename Weight>
+std::optional<typename ContractionHierarchy<Weight>::RouteInfo>
+ContractionHierarchy<Weight>::BuildRoute(VertexId from, VertexId to) const {
+  const size_t vertex_count = ranks_.size();
+  if (from >= vertex_count || to >= vertex_count) {
+    throw std::out_of_range("Vertex id is out of range");
+  }
+
+  SearchSpace& space = GetSearchSpace();
+  space.Reset(vertex_count);
+  const uint32_t stamp = space.stamp;
+
+  space.forward.Push(from, ZERO_WEIGHT, NO_EDGE, stamp);
+  space.backward.Push(to, ZERO_WEIGHT, NO_EDGE, stamp);
+
+  std::optional<Weight> best_weight;
+  VertexId meeting_vertex = from;
+
+  auto is_useful = [&best_weight](const SearchDirection& direction) {
+    return !direction.queue.Empty() &&
+           (!best_weight || direction.queue.Top().weight < *best_weight);
+  };
+
+  while (is_useful(space.forward) || is_useful(space.backward)) {
+    const bool is_forward =
+        is_useful(space.forward) &&
+        (!is_useful(space.backward) ||
+         !(space.backward.queue.Top().weight <
+           space.forward.queue.Top().weight));
+
+    SearchDirection& direction = is_forward ? space.forward : space.backward;
+    const SearchDirection& opposite =
+        is_forward ? space.backward : space.forward;
+
+    const auto [weight, vertex] = direction.queue.Pop();
+    if (direction.settled[vertex] == stamp) {
+      continue;
+    }
+    direction.settled[vertex] = stamp;
+
+    if (opposite.Reached(vertex, stamp)) {
+      const Weight candidate_weight = weight + opposite.weights[vertex];
+      if (!best_weight || candidate_weight < *best_weight) {
+        best_weight = candidate_weight;
+        meeting_vertex = vertex;
+      }
+    }
+
+    const auto& edge_ids =
+        is_forward ? upward_edges_[vertex] : downward_edges_[vertex];
+    for (const EdgeId edge_id : edge_ids) {
+      const auto& edge = edges_[edge_id];
+      direction.Push(is_forward ? edge.to : edge.from, weight + edge.weight,
+                     edge_id, stamp);
+    }
+  }
+
+  if (!best_weight) {
+    return std::nullopt;
+  }
+
+  std::vector<EdgeId> hierarchy_edges;
+  for (VertexId vertex = meeting_vertex; vertex != from;
+       vertex = edges_[hierarchy_edges.back()].from) {
+    hierarchy_edges.push_back(space.forward.prev_edges[vertex]);
+  }
+  std::reverse(hierarchy_edges.begin(), hierarchy_edges.end());
+
+  for (VertexId vertex = meeting_vertex; vertex != to;
+       vertex = edges_[hierarchy_edges.back()].to) {
+    hierarchy_edges.push_back(space.backward.prev_edges[vertex]);
+  }
+
+  std::vector<EdgeId> edges;
+  for (const EdgeId edge_id : hierarchy_edges) {
+    UnpackEdge(edge_id, edges);
+  }
+
+  return RouteInfo{*best_weight, std::move(edges)};
+}
+
+template <typename Weight>
+const std::vector<size_t>& ContractionHierarchy<Weight>::GetRanks() const {
+  return ranks_;
+}
+
+template <typename Weight>
+const std::vector<typename ContractionHierarchy<Weight>::HierarchyEdge>&
+ContractionHierarchy<Weight>::GetEdges() const {
+  return edges_;
+}
+
+}  // namespace graph
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "graph.h"
+#include "ranges.h"
+#include "weight_traits.h"
+
+namespace graph {
+
+// Frozen compressed sparse row copy of a DirectedWeightedGraph. Arcs leaving
+// a vertex are stored contiguously, ids are 32-bit and weights are converted
+// to Weight (usually a narrower type than the one of the source graph) by
+// WeightTraits.
+template <typename Weight>
+class CsrGraph {
+ public:
+  struct Arc {
+    uint32_t to;
+    Weight weight;
+  };
+
+  using IncidentEdges = ranges::Range<const Arc *>;
+
+  CsrGraph() = default;
+
+  template <typename SourceWeight>
+  explicit CsrGraph(const DirectedWeightedGraph<SourceWeight> &graph);
+
+  size_t GetVertexCount() const;
+  size_t GetEdgeCount() const;
+  IncidentEdges GetIncidentEdges(VertexId vertex) const;
+
+  size_t GetArcIndex(const Arc &arc) const;
+  VertexId GetArcSource(size_t arc_index) const;
+  EdgeId GetEdgeId(size_t arc_index) const;
+
+ private:
+  std::vector<uint32_t> offsets_;
+  std::vector<Arc> arcs_;
+  std::vector<uint32_t> edge_ids_;
+};
+
+template <typename Weight>
+template <typename SourceWeight>
+CsrGraph<Weight>::CsrGraph(const DirectedWeightedGraph<SourceWeight> &graph) {
+  const size_t vertex_count = graph.GetVertexCount();
+  const size_t edge_count = graph.GetEdgeCount();
+
+  if (vertex_count >= std::numeric_limits<uint32_t>::max() ||
+      edge_count >= std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("Graph is too large for 32-bit ids");
+  }
+
+  offsets_.reserve(vertex_count + 1);
+  arcs_.reserve(edge_count);
+  edge_ids_.reserve(edge_count);
+
+  offsets_.push_back(0);
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+      const auto &edge = graph.GetEdge(edge_id);
+
+      arcs_.push_back(Arc{static_cast<uint32_t>(edge.to),
+                          WeightTraits<Weight>::FromDouble(edge.weight)});
+      edge_ids_.push_back(static_cast<uint32_t>(edge_id));
+    }
+    offsets_.push_back(static_cast<uint32_t>(arcs_.size()));
+  }
+}
+
+template <typename Weight>
+size_t CsrGraph<Weight>::GetVertexCount() const {
+  return offsets_.empty() ? 0 : offsets_.size() - 1;
+}
+
+template <typename Weight>
+size_t CsrGraph<Weight>::GetEdgeCount() const {
+  return arcs_.size();
+}
+
+template <typename Weight>
+typename CsrGraph<Weight>::IncidentEdges CsrGraph<Weight>::GetIncidentEdges(
+    VertexId vertex) const {
+  const Arc *arcs = arcs_.data();
+  return IncidentEdges(arcs + offsets_.at(vertex), arcs + offsets_[vertex + 1]);
+}
+
+template <typename Weight>
+size_t CsrGraph<Weight>::GetArcIndex(const Arc &arc) const {
+  return &arc - arcs_.data();
+}
+
+template <typename Weight>
+VertexId CsrGraph<Weight>::GetArcSource(size_t arc_index) const {
+  const auto it = std::upper_bound(offsets_.begin(), offsets_.end(),
+                                   static_cast<uint32_t>(arc_index));
+  return std::distance(offsets_.begin(), it) - 1;
+}
+
+template <typename Weight>
+EdgeId CsrGraph<Weight>::GetEdgeId(size_t arc_index) const {
+  return edge_ids_.at(arc_index);
+}
+
+}  // namespace graph
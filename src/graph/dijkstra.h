@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph.h"
+#include "heap.h"
+#include "weight_traits.h"
+
+namespace graph {
+
+template <typename Weight, typename QueuePolicy = QuaternaryHeapPolicy>
+class DijkstraRouter {
+  using Graph = CsrGraph<Weight>;
+
+ public:
+  explicit DijkstraRouter(const Graph& graph);
+
+  struct RouteInfo {
+    Weight weight;
+    std::vector<EdgeId> edges;
+  };
+
+  // Shortest path tree of a single-source search. Answers routes from its
+  // source to any vertex without searching again.
+  class RoutesTree {
+   public:
+    std::optional<Weight> GetWeight(VertexId to) const;
+    std::optional<RouteInfo> BuildRoute(VertexId to) const;
+
+   private:
+    friend DijkstraRouter;
+    RoutesTree(const DijkstraRouter& router, VertexId from, Weight max_weight);
+
+    const DijkstraRouter& router_;
+    VertexId from_;
+    std::vector<Weight> weights_;
+    std::vector<uint32_t> prev_arcs_;
+    std::vector<bool> settled_;
+  };
+
+  std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+
+  // A* search. heuristic(vertex) should be a consistent lower bound of the
+  // weight of a route from vertex to `to`.
+  template <typename Heuristic>
+  std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to,
+                                      const Heuristic& heuristic) const;
+
+  RoutesTree BuildRoutesTree(VertexId from) const;
+  // Only the vertices up to max_weight away from `from` are settled.
+  RoutesTree BuildRoutesTree(VertexId from, Weight max_weight) const;
+
+ private:
+  static constexpr VertexId NO_VERTEX = std::numeric_limits<VertexId>::max();
+  static constexpr Weight MAX_WEIGHT = WeightTraits<Weight>::MAX;
+
+  struct QueueItem {
+    Weight weight;
+    VertexId vertex;
+
+    bool operator<(const QueueItem& other) const {
+      return weight < other.weight;
+    }
+
+    auto GetKey() const { return WeightTraits<Weight>::ToKey(weight); }
+  };
+
+  // Scratch arrays are shared by all searches of a thread. A vertex's entry is
+  // valid only if its stamp equals the stamp of the current search, so the
+  // arrays never have to be cleared between queries.
+  struct SearchSpace {
+    std::vector<Weight> weights;
+    std::vector<uint32_t> prev_arcs;
+    std::vector<uint32_t> reached;
+    std::vector<uint32_t> settled;
+    uint32_t stamp = 0;
+    typename QueuePolicy::template Queue<QueueItem> queue;
+
+    void Reset(size_t vertex_count) {
+      if (weights.size() < vertex_count) {
+        weights.resize(vertex_count);
+        prev_arcs.resize(vertex_count);
+        reached.resize(vertex_count, 0);
+        settled.resize(vertex_count, 0);
+      }
+
+      if (++stamp == 0) {
+        std::fill(reached.begin(), reached.end(), 0);
+        std::fill(settled.begin(), settled.end(), 0);
+        stamp = 1;
+      }
+
+      queue.Clear();
+    }
+
+    bool IsSettled(VertexId vertex) const { return settled[vertex] == stamp; }
+  };
+
+  static SearchSpace& GetSearchSpace() {
+    thread_local SearchSpace search_space;
+    return search_space;
+  }
+
+  // Settles vertices in order of weight plus heuristic until `to` is settled
+  // or, if `to` is NO_VERTEX, until every vertex up to max_weight away is.
+  template <typename Heuristic>
+  SearchSpace& Search(VertexId from, VertexId to, const Heuristic& heuristic,
+                      Weight max_weight = MAX_WEIGHT) const;
+
+  std::vector<EdgeId> UnpackRoute(VertexId from, VertexId to,
+                                  const std::vector<uint32_t>& prev_arcs) const;
+
+  static constexpr Weight ZERO_WEIGHT = WeightTraits<Weight>::ZERO;
+  const Graph& graph_;
+};
+
+template <typename Weight, typename QueuePolicy>
+DijkstraRouter<Weight, QueuePolicy>::DijkstraRouter(const Graph& graph)
+    : graph_(graph) {
+  for (VertexId vertex = 0; vertex < graph.GetVertexCount(); ++vertex) {
+    for (const auto& arc : graph.GetIncidentEdges(vertex)) {
+      if (arc.weight < ZERO_WEIGHT) {
+        throw std::domain_error("Edges' weights should be non-negative");
+      }
+    }
+  }
+}
+
+template <typename Weight, typename QueuePolicy>
+template <typename Heuristic>
+typename DijkstraRouter<Weight, QueuePolicy>::SearchSpace&
+DijkstraRouter<Weight, QueuePolicy>::Search(VertexId from, VertexId to,
+                                            const Heuristic& heuristic,
+                                            Weight max_weight) const {
+  const size_t vertex_count = graph_.GetVertexCount();
+  if (from >= vertex_count || (to != NO_VERTEX && to >= vertex_count)) {
+    throw std::out_of_range("Vertex id is out of range");
+  }
+
+  SearchSpace& space = GetSearchSpace();
+  space.Reset(vertex_count);
+
+  space.weights[from] = ZERO_WEIGHT;
+  space.reached[from] = space.stamp;
+  space.queue.Push({heuristic(from), from});
+
+  while (!space.queue.Empty()) {
+    const VertexId vertex = space.queue.Pop().vertex;
+    if (space.settled[vertex] == space.stamp) {
+      continue;
+    }
+    if (max_weight < space.weights[vertex]) {
+      break;
+    }
+    space.settled[vertex] = space.stamp;
+    const Weight weight = space.weights[vertex];
+
+    if (vertex == to) {
+      break;
+    }
+
+    for (const auto& arc : graph_.GetIncidentEdges(vertex)) {
+      const Weight candidate_weight = weight + arc.weight;
+
+      if (space.reached[arc.to] != space.stamp ||
+          candidate_weight < space.weights[arc.to]) {
+        space.reached[arc.to] = space.stamp;
+        space.weights[arc.to] = candidate_weight;
+        space.prev_arcs[arc.to] = graph_.GetArcIndex(arc);
+        space.queue.Push({candidate_weight + heuristic(arc.to), arc.to});
+      }
+    }
+  }
+
+  return space;
+}
+
+template <typename Weight, typename QueuePolicy>
+std::vector<EdgeId> DijkstraRouter<Weight, QueuePolicy>::UnpackRoute(
+    VertexId from, VertexId to, const std::vector<uint32_t>& prev_arcs) const {
+  std::vector<EdgeId> edges;
+  for (VertexId vertex = to; vertex != from;) {
+    const uint32_t arc_index = prev_arcs[vertex];
+    edges.push_back(graph_.GetEdgeId(arc_index));
+    vertex = graph_.GetArcSource(arc_index);
+  }
+
+  std::reverse(edges.begin(), edges.end());
+
+  return edges;
+}
+
+template <typename Weight, typename QueuePolicy>
+std::optional<typename DijkstraRouter<Weight, QueuePolicy>::RouteInfo>
+DijkstraRouter<Weight, QueuePolicy>::BuildRoute(VertexId from,
+                                                VertexId to) const {
+  return BuildRoute(from, to, [](VertexId) { return ZERO_WEIGHT; });
+}
+
+template <typename Weight, typename QueuePolicy>
+template <typename Heuristic>
+std::optional<typename DijkstraRouter<Weight, QueuePolicy>::RouteInfo>
+DijkstraRouter<Weight, QueuePolicy>::BuildRoute(
+    VertexId from, VertexId to, const Heuristic& heuristic) const {
+  const SearchSpace& space = Search(from, to, heuristic);
+
+  if (!space.IsSettled(to)) {
+    return std::nullopt;
+  }
+
+  return RouteInfo{space.weights[to], UnpackRoute(from, to, space.prev_arcs)};
+}
+
+template <typename Weight, typename QueuePolicy>
+typename DijkstraRouter<Weight, QueuePolicy>::RoutesTree
+DijkstraRouter<Weight, QueuePolicy>::BuildRoutesTree(VertexId from) const {
+  return RoutesTree(*this, from, MAX_WEIGHT);
+}
+
+template <typename Weight, typename QueuePolicy>
+typename DijkstraRouter<Weight, QueuePolicy>::RoutesTree
+DijkstraRouter<Weight, QueuePolicy>::BuildRoutesTree(
+    VertexId from, Weight max_weight) const {
+  return RoutesTree(*this, from, max_weight);
+}
+
+template <typename Weight, typename QueuePolicy>
+DijkstraRouter<Weight, QueuePolicy>::RoutesTree::RoutesTree(
+    const DijkstraRouter& router, VertexId from, Weight max_weight)
+    : router_(router), from_(from) {
+  const size_t vertex_count = router.graph_.GetVertexCount();
+  const SearchSpace& space = router.Search(
+      from, NO_VERTEX, [](VertexId) { return ZERO_WEIGHT; }, max_weight);
+
+  weights_.assign(space.weights.begin(), space.weights.begin() + vertex_count);
+  prev_arcs_.assign(space.prev_arcs.begin(),
+                    space.prev_arcs.begin() + vertex_count);
+  settled_.resize(vertex_count);
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    settled_[vertex] = space.IsSettled(vertex);
+  }
+}
+
+template <typename Weight, typename QueuePolicy>
+std::optional<Weight>
+DijkstraRouter<Weight, QueuePolicy>::RoutesTree::GetWeight(VertexId to) const {
+  if (!settled_.at(to)) {
+    return std::nullopt;
+  }
+  return weights_[to];
+}
+
+template <typename Weight, typename QueuePolicy>
+std::optional<typename DijkstraRouter<Weight, QueuePolicy>::RouteInfo>
+DijkstraRouter<Weight, QueuePolicy>::RoutesTree::BuildRoute(
+    VertexId to) const {
+  if (!settled_.at(to)) {
+    return std::nullopt;
+  }
+  return RouteInfo{weights_[to], router_.UnpackRoute(from_, to, prev_arcs_)};
+}
+
+}  // namespace graph
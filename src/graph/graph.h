@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 
@@ -32,7 +33,11 @@ class DirectedWeightedGraph {
  public:
   DirectedWeightedGraph() = default;
   explicit DirectedWeightedGraph(size_t vertex_count);
+  VertexId AddVertex();
   EdgeId AddEdge(const Edge<Weight> &edge);
+  void SetEdgeWeight(EdgeId edge_id, Weight weight);
+  // A removed edge keeps its id, but is no longer incident to its vertex.
+  void RemoveEdge(EdgeId edge_id);
 
   size_t GetVertexCount() const;
   size_t GetEdgeCount() const;
@@ -48,6 +53,12 @@ template <typename Weight>
 DirectedWeightedGraph<Weight>::DirectedWeightedGraph(size_t vertex_count)
     : incidences_(vertex_count) {}
 
+template <typename Weight>
+VertexId DirectedWeightedGraph<Weight>::AddVertex() {
+  incidences_.emplace_back();
+  return incidences_.size() - 1;
+}
+
 template <typename Weight>
 EdgeId DirectedWeightedGraph<Weight>::AddEdge(const Edge<Weight> &edge) {
   edges_.push_back(edge);
@@ -56,6 +67,19 @@ EdgeId DirectedWeightedGraph<Weight>::AddEdge(const Edge<Weight> &edge) {
   return id;
 }
 
+template <typename Weight>
+void DirectedWeightedGraph<Weight>::SetEdgeWeight(EdgeId edge_id,
+                                                  Weight weight) {
+  edges_.at(edge_id).weight = weight;
+}
+
+template <typename Weight>
+void DirectedWeightedGraph<Weight>::RemoveEdge(EdgeId edge_id) {
+  auto &incidence = incidences_.at(edges_.at(edge_id).from);
+  incidence.erase(std::remove(incidence.begin(), incidence.end(), edge_id),
+                  incidence.end());
+}
+
 template <typename Weight>
 size_t DirectedWeightedGraph<Weight>::GetVertexCount() const {
   return incidences_.size();
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+template <typename T, size_t Arity = 4, typename Compare = std::less<T>>
+class DaryHeap {
+  static_assert(Arity >= 2, "Heap arity should be at least 2");
+
+ public:
+  bool Empty() const { return items_.empty(); }
+  size_t Size() const { return items_.size(); }
+  void Clear() { items_.clear(); }
+
+  const T& Top() const { return items_.front(); }
+
+  void Push(T item) {
+    items_.push_back(std::move(item));
+    SiftUp(items_.size() - 1);
+  }
+
+  T Pop() {
+    T top = std::move(items_.front());
+    items_.front() = std::move(items_.back());
+    items_.pop_back();
+
+    if (!items_.empty()) {
+      SiftDown(0);
+    }
+
+    return top;
+  }
+
+ private:
+  void SiftUp(size_t index) {
+    T item = std::move(items_[index]);
+
+    while (index > 0) {
+      const size_t parent = (index - 1) / Arity;
+      if (!compare_(item, items_[parent])) {
+        break;
+      }
+      items_[index] = std::move(items_[parent]);
+      index = parent;
+    }
+
+    items_[index] = std::move(item);
+  }
+
+  void SiftDown(size_t index) {
+    const size_t size = items_.size();
+    T item = std::move(items_[index]);
+
+    while (true) {
+      const size_t first_child = index * Arity + 1;
+      if (first_child >= size) {
+        break;
+      }
+
+      const size_t last_child = std::min(first_child + Arity, size);
+      size_t best_child = first_child;
+      for (size_t child = first_child + 1; child < last_child; ++child) {
+        if (compare_(items_[child], items_[best_child])) {
+          best_child = child;
+        }
+      }
+
+      if (!compare_(items_[best_child], item)) {
+        break;
+      }
+      items_[index] = std::move(items_[best_child]);
+      index = best_child;
+    }
+
+    items_[index] = std::move(item);
+  }
+
+  std::vector<T> items_;
+  Compare compare_;
+};
+
+// Monotone priority queue of items with unsigned integer keys T::GetKey():
+// no key pushed is less than the last popped one, smaller keys are taken as
+// equal to it. Items are kept in buckets by the highest bit in which their key
+// differs from the last popped key, so every item is moved to a lower bucket
+// at most once per key bit.
+template <typename T>
+class RadixHeap {
+  using Key = std::decay_t<decltype(std::declval<const T&>().GetKey())>;
+  static_assert(std::is_unsigned_v<Key>, "Radix heap keys should be unsigned");
+
+ public:
+  bool Empty() const { return size_ == 0; }
+  size_t Size() const { return size_; }
+
+  void Clear() {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+    size_ = 0;
+    last_key_ = 0;
+  }
+
+  void Push(T item) {
+    const Key key = std::max(item.GetKey(), last_key_);
+    buckets_[GetBucket(key)].push_back({key, std::move(item)});
+    ++size_;
+  }
+
+  T Pop() {
+    if (buckets_[0].empty()) {
+      size_t index = 1;
+      while (buckets_[index].empty()) {
+        ++index;
+      }
+
+      auto& bucket = buckets_[index];
+      last_key_ = std::min_element(bucket.begin(), bucket.end(),
+                                   [](const Entry& left, const Entry& right) {
+                                     return left.key < right.key;
+                                   })
+                      ->key;
+      for (auto& entry : bucket) {
+        buckets_[GetBucket(entry.key)].push_back(std::move(entry));
+      }
+      bucket.clear();
+    }
+
+    T item = std::move(buckets_[0].back().item);
+    buckets_[0].pop_back();
+    --size_;
+
+    return item;
+  }
+
+ private:
+  static constexpr size_t KEY_BITS = sizeof(Key) * CHAR_BIT;
+
+  struct Entry {
+    Key key;
+    T item;
+  };
+
+  size_t GetBucket(Key key) const {
+    const unsigned long long difference = key ^ last_key_;
+    return difference == 0 ? 0 : 64 - __builtin_clzll(difference);
+  }
+
+  std::array<std::vector<Entry>, KEY_BITS + 1> buckets_;
+  size_t size_ = 0;
+  Key last_key_ = 0;
+};
+
+// Priority queue policies of the searches: Queue<T> is a queue popping the
+// least T first.
+template <size_t Arity>
+struct DaryHeapPolicy {
+  template <typename T>
+  using Queue = DaryHeap<T, Arity>;
+};
+
+using BinaryHeapPolicy = DaryHeapPolicy<2>;
+using QuaternaryHeapPolicy = DaryHeapPolicy<4>;
+
+// Only for items with integer keys and searches settling vertices in order of
+// their keys.
+struct RadixHeapPolicy {
+  template <typename T>
+  using Queue = RadixHeap<T>;
+};
+
+}  // namespace graph
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "heap.h"
+
+namespace graph {
+
+// Every vertex keeps two labels: the hubs it reaches and the hubs it is
+// reached from, together with the route weights. Every shortest route passes
+// through a hub common to the out label of its start and the in label of its
+// finish, so a query merges two short arrays sorted by hub rank. The labels
+// are built by pruned searches from the vertices in the order of their degree
+// (pruned landmark labeling): a search stops at vertices whose route to the
+// hub is already answered by the labels of the previous hubs.
+template <typename Weight>
+class HubLabels {
+  using Graph = DirectedWeightedGraph<Weight>;
+
+ public:
+  static constexpr uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max();
+
+  // The hub is given by its rank. The edge is the parent hint of the route:
+  // the first edge of the route to the hub for out labels, the last edge of
+  // the route from the hub for in labels, none for the hub itself.
+  struct Label {
+    uint32_t hub;
+    Weight weight;
+    uint32_t edge = NO_EDGE;
+  };
+
+  // The labels of all vertices one after another, the labels of a vertex
+  // start at its offset.
+  struct Labels {
+    std::vector<size_t> offsets;
+    std::vector<Label> labels;
+  };
+
+  struct HubLabelsData {
+    std::vector<VertexId> hubs;
+    Labels out_labels;
+    Labels in_labels;
+  };
+
+  explicit HubLabels(const Graph& graph);
+  HubLabels(const Graph& graph, HubLabelsData data);
+
+  struct RouteInfo {
+    Weight weight;
+    std::vector<EdgeId> edges;
+  };
+
+  std::optional<Weight> GetWeight(VertexId from, VertexId to) const;
+  std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+
+  const HubLabelsData& GetHubLabelsData() const;
+
+ private:
+  struct QueueItem {
+    Weight weight;
+    VertexId vertex;
+
+    bool operator<(const QueueItem& other) const {
+      return weight < other.weight;
+    }
+  };
+
+  struct Construction {
+    std::vector<std::vector<EdgeId>> in_edges;
+    std::vector<std::vector<Label>> out_labels;
+    std::vector<std::vector<Label>> in_labels;
+
+    // Route weights of the current hub to or from the previous hubs.
+    std::vector<Weight> hub_weights;
+    std::vector<bool> is_hub_reached;
+
+    std::vector<Weight> weights;
+    std::vector<uint32_t> prev_edges;
+    std::vector<size_t> reached;
+    std::vector<size_t> settled;
+    size_t stamp = 0;
+    DaryHeap<QueueItem, 4> queue;
+  };
+
+  void SearchFromHub(Construction& construction, uint32_t hub, bool forward);
+  std::optional<std::pair<Weight, uint32_t>> FindCommonHub(VertexId from,
+                                                           VertexId to) const;
+  const Label& FindLabel(const Labels& labels, VertexId vertex,
+                         uint32_t hub) const;
+
+  static constexpr Weight ZERO_WEIGHT{};
+  const Graph& graph_;
+  HubLabelsData data_;
+};
+
+template <typename Weight>
+HubLabels<Weight>::HubLabels(const Graph& graph) : graph_(graph) {
+  const size_t vertex_count = graph.GetVertexCount();
+  if (vertex_count >= NO_EDGE || graph.GetEdgeCount() >= NO_EDGE) {
+    throw std::length_error("Graph is too large for 32-bit ids");
+  }
+
+  Construction construction;
+  construction.in_edges.resize(vertex_count);
+  construction.out_labels.resize(vertex_count);
+  construction.in_labels.resize(vertex_count);
+  construction.hub_weights.resize(vertex_count);
+  construction.is_hub_reached.resize(vertex_count, false);
+  construction.weights.resize(vertex_count);
+  construction.prev_edges.resize(vertex_count, NO_EDGE);
+  construction.reached.resize(vertex_count, 0);
+  construction.settled.resize(vertex_count, 0);
+
+  std::vector<size_t> degrees(vertex_count, 0);
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+      const auto& edge = graph.GetEdge(edge_id);
+      if (edge.weight < ZERO_WEIGHT) {
+        throw std::domain_error("Edges' weights should be non-negative");
+      }
+
+      construction.in_edges[edge.to].push_back(edge_id);
+      ++degrees[edge.from];
+      ++degrees[edge.to];
+    }
+  }
+
+  data_.hubs.resize(vertex_count);
+  std::iota(data_.hubs.begin(), data_.hubs.end(), 0);
+  std::stable_sort(data_.hubs.begin(), data_.hubs.end(),
+                   [&degrees](VertexId left, VertexId right) {
+                     return degrees[left] > degrees[right];
+                   });
+
+  for (uint32_t hub = 0; hub < vertex_count; ++hub) {
+    SearchFromHub(construction, hub, true);
+    SearchFromHub(construction, hub, false);
+  }
+
+  auto flatten = [vertex_count](std::vector<std::vector<Label>>& labels) {
+    Labels result;
+    result.offsets.reserve(vertex_count + 1);
+    result.offsets.push_back(0);
+
+    for (auto& vertex_labels : labels) {
+      result.labels.insert(result.labels.end(), vertex_labels.begin(),
+                           vertex_labels.end());
+      result.offsets.push_back(result.labels.size());
+      vertex_labels = {};
+    }
+
+    return result;
+  };
+
+  data_.out_labels = flatten(construction.out_labels);
+  data_.in_labels = flatten(construction.in_labels);
+}
+
+template <typename Weight>
+HubLabels<Weight>::HubLabels(const Graph& graph, HubLabelsData data)
+    : graph_(graph), data_(std::move(data)) {}
+
+// A forward search finds the routes from the hub and adds it to the in labels
+// of the vertices it reaches, a backward search goes along reversed edges and
+// fills the out labels.
+template <typename Weight>
+void HubLabels<Weight>::SearchFromHub(Construction& construction, uint32_t hub,
+                                      bool forward) {
+  auto& hub_labels =
+      forward ? construction.out_labels : construction.in_labels;
+  auto& vertex_labels =
+      forward ? construction.in_labels : construction.out_labels;
+  const VertexId hub_vertex = data_.hubs[hub];
+
+  for (const Label& label : hub_labels[hub_vertex]) {
+    construction.hub_weights[label.hub] = label.weight;
+    construction.is_hub_reached[label.hub] = true;
+  }
+
+  const size_t stamp = ++construction.stamp;
+  auto& hub_weights = construction.hub_weights;
+  auto& is_hub_reached = construction.is_hub_reached;
+  auto& weights = construction.weights;
+  auto& prev_edges = construction.prev_edges;
+  auto& reached = construction.reached;
+  auto& settled = construction.settled;
+  auto& queue = construction.queue;
+
+  auto relax = [&](EdgeId edge_id, VertexId next, Weight next_weight) {
+    if (settled[next] != stamp &&
+        (reached[next] != stamp || next_weight < weights[next])) {
+      reached[next] = stamp;
+      weights[next] = next_weight;
+      prev_edges[next] = static_cast<uint32_t>(edge_id);
+      queue.Push({next_weight, next});
+    }
+  };
+
+  weights[hub_vertex] = ZERO_WEIGHT;
+  prev_edges[hub_vertex] = NO_EDGE;
+  reached[hub_vertex] = stamp;
+  queue.Clear();
+  queue.Push({ZERO_WEIGHT, hub_vertex});
+
+  while (!queue.Empty()) {
+    const auto [weight, vertex] = queue.Pop();
+    if (settled[vertex] == stamp) {
+      continue;
+    }
+    settled[vertex] = stamp;
+
+    const bool is_pruned = std::any_of(
+        vertex_labels[vertex].begin(), vertex_labels[vertex].end(),
+        [&, weight = weight](const Label& label) {
+          return is_hub_reached[label.hub] &&
+                 !(weight < hub_weights[label.hub] + label.weight);
+        });
+    if (is_pruned) {
+      continue;
+    }
+
+    vertex_labels[vertex].push_back({hub, weight, prev_edges[vertex]});
+
+    if (forward) {
+      for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+        const auto& edge = graph_.GetEdge(edge_id);
+        relax(edge_id, edge.to, weight + edge.weight);
+      }
+    } else {
+      for (const EdgeId edge_id : construction.in_edges[vertex]) {
+        const auto& edge = graph_.GetEdge(edge_id);
+        relax(edge_id, edge.from, weight + edge.weight);
+      }
+    }
+  }
+
+  for (const Label& label : hub_labels[hub_vertex]) {
+    is_hub_reached[label.hub] = false;
+  }
+}
+
+template <typename Weight>
+std::optional<std::pair<Weight, uint32_t>> HubLabels<Weight>::FindCommonHub(
+    VertexId from, VertexId to) const {
+  const auto& out = data_.out_labels;
+  const auto& in = data_.in_labels;
+  const size_t vertex_count = data_.hubs.size();
+  if (from >= vertex_count || to >= vertex_count) {
+    throw std::out_of_range("Vertex id is out of range");
+  }
+
+  std::optional<std::pair<Weight, uint32_t>> result;
+
+  auto out_it = out.labels.begin() + out.offsets[from];
+  const auto out_end = out.labels.begin() + out.offsets[from + 1];
+  auto in_it = in.labels.begin() + in.offsets[to];
+  const auto in_end = in.labels.begin() + in.offsets[to + 1];
+
+  while (out_it != out_end && in_it != in_end) {
+    if (out_it->hub < in_it->hub) {
+      ++out_it;
+    } else if (in_it->hub < out_it->hub) {
+      ++in_it;
+    } else {
+      const Weight weight = out_it->weight + in_it->weight;
+      if (!result || weight < result->first) {
+        result = {weight, out_it->hub};
+      }
+      ++out_it;
+      ++in_it;
+    }
+  }
+
+  return result;
+}
+
+template <typename Weight>
+const typename HubLabels<Weight>::Label& HubLabels<Weight>::FindLabel(
+    const Labels& labels, VertexId vertex, uint32_t hub) const {
+  const auto first = labels.labels.begin() + labels.offsets[vertex];
+  const auto last = labels.labels.begin() + labels.offsets[vertex + 1];
+
+  return *std::lower_bound(
+      first, last, hub,
+      [](const Label& label, uint32_t hub) { return label.hub < hub; });
+}
+
+template <typename Weight>
+std::optional<Weight> HubLabels<Weight>::GetWeight(VertexId from,
+                                                   VertexId to) const {
+  if (const auto common_hub = FindCommonHub(from, to)) {
+    return common_hub->first;
+  }
+  return std::nullopt;
+}
+
+// Every vertex on the route of a label was expanded by the search of its hub,
+// so it has a label of the same hub with the next parent hint.
+template <typename Weight>
+std::optional<typename HubLabels<Weight>::RouteInfo>
+HubLabels<Weight>::BuildRoute(VertexId from, VertexId to) const {
+  const auto common_hub = FindCommonHub(from, to);
+  if (!common_hub) {
+    return std::nullopt;
+  }
+
+  const auto [weight, hub] = *common_hub;
+  const VertexId hub_vertex = data_.hubs[hub];
+  std::vector<EdgeId> edges;
+
+  for (VertexId vertex = from; vertex != hub_vertex;) {
+    const EdgeId edge_id = FindLabel(data_.out_labels, vertex, hub).edge;
+    edges.push_back(edge_id);
+    vertex = graph_.GetEdge(edge_id).to;
+  }
+
+  const size_t in_route_begin = edges.size();
+  for (VertexId vertex = to; vertex != hub_vertex;) {
+    const EdgeId edge_id = FindLabel(data_.in_labels, vertex, hub).edge;
+    edges.push_back(edge_id);
+    vertex = graph_.GetEdge(edge_id).from;
+  }
+  std::reverse(edges.begin() + in_route_begin, edges.end());
+
+  return RouteInfo{weight, std::move(edges)};
+}
+
+template <typename Weight>
+const typename HubLabels<Weight>::HubLabelsData&
+HubLabels<Weight>::GetHubLabelsData() const {
+  return data_;
+}
+
+}  // namespace graph
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include "weight_traits.h"
+
+namespace graph {
+
+// Route weights from and to a few landmark vertices. By the triangle
+// inequality they bound the weight of any route from below, which makes a
+// consistent A* heuristic (ALT). Landmarks are chosen farthest first: the
+// next landmark is the vertex farthest from all the landmarks chosen before.
+template <typename Weight>
+class Landmarks {
+ public:
+  static constexpr Weight NO_ROUTE = WeightTraits<Weight>::MAX;
+
+  // Weights are stored vertex by vertex, the weights of a vertex are
+  // landmark_count consecutive items in the order of the landmarks.
+  struct LandmarksData {
+    std::vector<VertexId> landmarks;
+    std::vector<Weight> weights_from;
+    std::vector<Weight> weights_to;
+  };
+
+  template <typename SourceWeight>
+  Landmarks(const DirectedWeightedGraph<SourceWeight>& graph,
+            size_t landmark_count);
+  explicit Landmarks(LandmarksData data);
+
+  // Lower bound of the weight of a route from `from` to `to`.
+  Weight GetLowerBound(VertexId from, VertexId to) const;
+
+  const LandmarksData& GetLandmarksData() const;
+
+ private:
+  static constexpr Weight ZERO_WEIGHT = WeightTraits<Weight>::ZERO;
+
+  LandmarksData data_;
+  size_t landmark_count_ = 0;
+};
+
+template <typename Weight>
+template <typename SourceWeight>
+Landmarks<Weight>::Landmarks(const DirectedWeightedGraph<SourceWeight>& graph,
+                             size_t landmark_count) {
+  const size_t vertex_count = graph.GetVertexCount();
+
+  DirectedWeightedGraph<SourceWeight> reversed_graph(vertex_count);
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+      const auto& edge = graph.GetEdge(edge_id);
+      reversed_graph.AddEdge({edge.to, edge.from, edge.weight});
+    }
+  }
+
+  const CsrGraph<Weight> forward_graph(graph);
+  const CsrGraph<Weight> backward_graph(reversed_graph);
+  const DijkstraRouter<Weight> forward_router(forward_graph);
+  const DijkstraRouter<Weight> backward_router(backward_graph);
+
+  // Only vertices with both incoming and outgoing edges are worth being a
+  // landmark, the others are ends of routes at most.
+  auto has_edges = [](const auto& edges) {
+    return edges.begin() != edges.end();
+  };
+  std::vector<bool> is_candidate(vertex_count);
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    is_candidate[vertex] =
+        has_edges(forward_graph.GetIncidentEdges(vertex)) &&
+        has_edges(backward_graph.GetIncidentEdges(vertex));
+  }
+
+  // The first landmark is the vertex farthest from vertex 0.
+  std::vector<Weight> landmark_weights(vertex_count, ZERO_WEIGHT);
+  if (vertex_count > 0) {
+    const auto routes_tree = forward_router.BuildRoutesTree(0);
+    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+      landmark_weights[vertex] = routes_tree.GetWeight(vertex).value_or(
+          vertex == 0 ? ZERO_WEIGHT : NO_ROUTE);
+    }
+  }
+
+  std::vector<std::vector<Weight>> weights_from;
+  std::vector<std::vector<Weight>> weights_to;
+
+  while (data_.landmarks.size() < landmark_count) {
+    std::optional<VertexId> landmark;
+    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+      if (is_candidate[vertex] &&
+          (!landmark ||
+           landmark_weights[*landmark] < landmark_weights[vertex])) {
+        landmark = vertex;
+      }
+    }
+    if (!landmark) {
+      break;
+    }
+    data_.landmarks.push_back(*landmark);
+    is_candidate[*landmark] = false;
+
+    auto& from = weights_from.emplace_back(vertex_count, NO_ROUTE);
+    auto& to = weights_to.emplace_back(vertex_count, NO_ROUTE);
+    const auto forward_tree = forward_router.BuildRoutesTree(*landmark);
+    const auto backward_tree = backward_router.BuildRoutesTree(*landmark);
+
+    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+      from[vertex] = forward_tree.GetWeight(vertex).value_or(NO_ROUTE);
+      to[vertex] = backward_tree.GetWeight(vertex).value_or(NO_ROUTE);
+
+      if (data_.landmarks.size() == 1 ||
+          from[vertex] < landmark_weights[vertex]) {
+        landmark_weights[vertex] = from[vertex];
+      }
+    }
+  }
+
+  landmark_count_ = data_.landmarks.size();
+  data_.weights_from.reserve(vertex_count * landmark_count_);
+  data_.weights_to.reserve(vertex_count * landmark_count_);
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    for (size_t index = 0; index < landmark_count_; ++index) {
+      data_.weights_from.push_back(weights_from[index][vertex]);
+      data_.weights_to.push_back(weights_to[index][vertex]);
+    }
+  }
+}
+
+template <typename Weight>
+Landmarks<Weight>::Landmarks(LandmarksData data)
+    : data_(std::move(data)), landmark_count_(data_.landmarks.size()) {}
+
+// Routes from a landmark: weight(L, to) <= weight(L, from) + weight(from, to),
+// routes to a landmark: weight(from, L) <= weight(from, to) + weight(to, L).
+// A bound is only taken when both of its routes exist.
+template <typename Weight>
+Weight Landmarks<Weight>::GetLowerBound(VertexId from, VertexId to) const {
+  auto get_weights = [this](const std::vector<Weight>& weights,
+                            VertexId vertex) {
+    return weights.begin() + vertex * landmark_count_;
+  };
+  const auto from_weights_from = get_weights(data_.weights_from, from);
+  const auto to_weights_from = get_weights(data_.weights_from, to);
+  const auto from_weights_to = get_weights(data_.weights_to, from);
+  const auto to_weights_to = get_weights(data_.weights_to, to);
+
+  Weight bound = ZERO_WEIGHT;
+  for (size_t index = 0; index < landmark_count_; ++index) {
+    if (from_weights_from[index] < to_weights_from[index] &&
+        to_weights_from[index] != NO_ROUTE) {
+      bound = std::max(bound,
+                       to_weights_from[index] - from_weights_from[index]);
+    }
+    if (to_weights_to[index] < from_weights_to[index] &&
+        from_weights_to[index] != NO_ROUTE) {
+      bound = std::max(bound, from_weights_to[index] - to_weights_to[index]);
+    }
+  }
+
+  return bound;
+}
+
+template <typename Weight>
+const typename Landmarks<Weight>::LandmarksData&
+Landmarks<Weight>::GetLandmarksData() const {
+  return data_;
+}
+
+}  // namespace graph
@@ -0,0 +1,110 @@
+#include "min_plus.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIN_PLUS_X86
+#include <immintrin.h>
+#endif
+
+namespace graph::min_plus {
+
+namespace {
+
+using RelaxRowFunction = size_t (*)(void*, const void*, size_t, float,
+                                    uint32_t);
+
+size_t RelaxRowScalar(void*, const void*, size_t, float, uint32_t) {
+  return 0;
+}
+
+#ifdef MIN_PLUS_X86
+
+// Weights are in the even lanes and edge ids in the odd lanes of a vector,
+// a candidate replaces the cell when the weight lane compares less.
+__attribute__((target("avx2"))) size_t RelaxRowAvx2(
+    void* row, const void* through_row, size_t count, float through_weight,
+    uint32_t through_edge) {
+  constexpr size_t CELLS = 4;
+  auto* cells = static_cast<float*>(row);
+  const auto* through_cells = static_cast<const float*>(through_row);
+
+  const __m256 weight = _mm256_set1_ps(through_weight);
+  const __m256i edge = _mm256_set1_epi32(static_cast<int>(through_edge));
+  const __m256i no_edge = _mm256_set1_epi32(-1);
+
+  size_t i = 0;
+  for (; i + CELLS <= count; i += CELLS) {
+    const __m256 through_cell = _mm256_loadu_ps(through_cells + 2 * i);
+    const __m256 cell = _mm256_loadu_ps(cells + 2 * i);
+
+    const __m256 candidate = _mm256_add_ps(through_cell, weight);
+    const __m256 is_lighter =
+        _mm256_moveldup_ps(_mm256_cmp_ps(candidate, cell, _CMP_LT_OQ));
+
+    const __m256i through_edges = _mm256_castps_si256(through_cell);
+    const __m256i edges = _mm256_blendv_epi8(
+        through_edges, edge, _mm256_cmpeq_epi32(through_edges, no_edge));
+    const __m256 relaxed =
+        _mm256_blend_ps(candidate, _mm256_castsi256_ps(edges), 0b10101010);
+
+    _mm256_storeu_ps(cells + 2 * i,
+                     _mm256_blendv_ps(cell, relaxed, is_lighter));
+  }
+
+  return i;
+}
+
+__attribute__((target("sse4.1"))) size_t RelaxRowSse41(
+    void* row, const void* through_row, size_t count, float through_weight,
+    uint32_t through_edge) {
+  constexpr size_t CELLS = 2;
+  auto* cells = static_cast<float*>(row);
+  const auto* through_cells = static_cast<const float*>(through_row);
+
+  const __m128 weight = _mm_set1_ps(through_weight);
+  const __m128i edge = _mm_set1_epi32(static_cast<int>(through_edge));
+  const __m128i no_edge = _mm_set1_epi32(-1);
+
+  size_t i = 0;
+  for (; i + CELLS <= count; i += CELLS) {
+    const __m128 through_cell = _mm_loadu_ps(through_cells + 2 * i);
+    const __m128 cell = _mm_loadu_ps(cells + 2 * i);
+
+    const __m128 candidate = _mm_add_ps(through_cell, weight);
+    const __m128 is_lighter = _mm_moveldup_ps(_mm_cmplt_ps(candidate, cell));
+
+    const __m128i through_edges = _mm_castps_si128(through_cell);
+    const __m128i edges = _mm_blendv_epi8(
+        through_edges, edge, _mm_cmpeq_epi32(through_edges, no_edge));
+    const __m128 relaxed =
+        _mm_blend_ps(candidate, _mm_castsi128_ps(edges), 0b1010);
+
+    _mm_storeu_ps(cells + 2 * i, _mm_blendv_ps(cell, relaxed, is_lighter));
+  }
+
+  return i;
+}
+
+#endif
+
+RelaxRowFunction ChooseRelaxRow() {
+#ifdef MIN_PLUS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return RelaxRowAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return RelaxRowSse41;
+  }
+#endif
+  return RelaxRowScalar;
+}
+
+}  // namespace
+
+size_t RelaxRow(void* row, const void* through_row, size_t count,
+                float through_weight, uint32_t through_edge) {
+  static const RelaxRowFunction relax_row = ChooseRelaxRow();
+  return relax_row(row, through_row, count, through_weight, through_edge);
+}
+
+}  // namespace graph::min_plus
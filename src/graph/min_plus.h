@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace graph::min_plus {
+
+// Relaxes the first cells of row through a vertex: every cell becomes
+// through_weight + through_row[i].weight when that is lighter. Cells are pairs
+// of a float weight and a uint32_t edge id, a cell of through_row without an
+// edge passes through_edge on. The cells are processed with the widest vector
+// instructions the CPU supports, the number of processed cells is returned
+// and the rest is left to the caller.
+size_t RelaxRow(void* row, const void* through_row, size_t count,
+                float through_weight, uint32_t through_edge);
+
+}  // namespace graph::min_plus
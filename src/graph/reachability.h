@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+namespace graph {
+
+// Reachability labels of the vertices: the strongly connected component,
+// numbered in reverse topological order of the components, and the weakly
+// connected component. A route only exists inside a weak component and never
+// leads to a component with a greater number, so most pairs of vertices
+// without a route are told apart by comparing two numbers.
+class ReachabilityLabels {
+ public:
+  struct Label {
+    uint32_t component;
+    uint32_t weak_component;
+  };
+
+  template <typename Weight>
+  explicit ReachabilityLabels(const DirectedWeightedGraph<Weight>& graph);
+  explicit ReachabilityLabels(std::vector<Label> labels);
+
+  // False when there is no route from `from` to `to`, true when there may be
+  // one.
+  bool MayHaveRoute(VertexId from, VertexId to) const;
+
+  const std::vector<Label>& GetLabels() const;
+
+ private:
+  template <typename Weight>
+  void InitComponents(const DirectedWeightedGraph<Weight>& graph);
+  template <typename Weight>
+  void InitWeakComponents(const DirectedWeightedGraph<Weight>& graph);
+
+  std::vector<Label> labels_;
+};
+
+template <typename Weight>
+ReachabilityLabels::ReachabilityLabels(
+    const DirectedWeightedGraph<Weight>& graph)
+    : labels_(graph.GetVertexCount()) {
+  InitComponents(graph);
+  InitWeakComponents(graph);
+}
+
+inline ReachabilityLabels::ReachabilityLabels(std::vector<Label> labels)
+    : labels_(std::move(labels)) {}
+
+inline bool ReachabilityLabels::MayHaveRoute(VertexId from,
+                                             VertexId to) const {
+  const Label& from_label = labels_.at(from);
+  const Label& to_label = labels_.at(to);
+  return from_label.weak_component == to_label.weak_component &&
+         to_label.component <= from_label.component;
+}
+
+inline const std::vector<ReachabilityLabels::Label>&
+ReachabilityLabels::GetLabels() const {
+  return labels_;
+}
+
+// Tarjan's algorithm with an explicit stack of calls. A component is
+// numbered when its search is finished, so the components it leads to are
+// numbered before it.
+template <typename Weight>
+void ReachabilityLabels::InitComponents(
+    const DirectedWeightedGraph<Weight>& graph) {
+  constexpr uint32_t NOT_VISITED = std::numeric_limits<uint32_t>::max();
+  const size_t vertex_count = graph.GetVertexCount();
+
+  std::vector<uint32_t> indexes(vertex_count, NOT_VISITED);
+  std::vector<uint32_t> low_links(vertex_count);
+  std::vector<bool> is_on_stack(vertex_count, false);
+  std::vector<VertexId> stack;
+  // Vertices being searched with the number of their edges already followed.
+  std::vector<std::pair<VertexId, size_t>> calls;
+  uint32_t index = 0;
+  uint32_t component = 0;
+
+  auto visit = [&](VertexId vertex) {
+    indexes[vertex] = low_links[vertex] = index++;
+    stack.push_back(vertex);
+    is_on_stack[vertex] = true;
+    calls.emplace_back(vertex, 0);
+  };
+
+  for (VertexId root = 0; root < vertex_count; ++root) {
+    if (indexes[root] != NOT_VISITED) {
+      continue;
+    }
+    visit(root);
+
+    while (!calls.empty()) {
+      const auto [vertex, followed] = calls.back();
+      const auto edges = graph.GetIncidentEdges(vertex);
+
+      if (edges.begin() + followed != edges.end()) {
+        ++calls.back().second;
+        const VertexId next = graph.GetEdge(*(edges.begin() + followed)).to;
+        if (indexes[next] == NOT_VISITED) {
+          visit(next);
+        } else if (is_on_stack[next]) {
+          low_links[vertex] = std::min(low_links[vertex], indexes[next]);
+        }
+        continue;
+      }
+
+      calls.pop_back();
+      if (!calls.empty()) {
+        const VertexId parent = calls.back().first;
+        low_links[parent] = std::min(low_links[parent], low_links[vertex]);
+      }
+
+      if (low_links[vertex] == indexes[vertex]) {
+        VertexId member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          is_on_stack[member] = false;
+          labels_[member].component = component;
+        } while (member != vertex);
+        ++component;
+      }
+    }
+  }
+}
+
+template <typename Weight>
+void ReachabilityLabels::InitWeakComponents(
+    const DirectedWeightedGraph<Weight>& graph) {
+  const size_t vertex_count = graph.GetVertexCount();
+
+  std::vector<VertexId> parents(vertex_count);
+  std::iota(parents.begin(), parents.end(), 0);
+  auto find_root = [&parents](VertexId vertex) {
+    while (parents[vertex] != vertex) {
+      parents[vertex] = parents[parents[vertex]];
+      vertex = parents[vertex];
+    }
+    return vertex;
+  };
+
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+      const VertexId from_root = find_root(vertex);
+      const VertexId to_root = find_root(graph.GetEdge(edge_id).to);
+      parents[std::max(from_root, to_root)] = std::min(from_root, to_root);
+    }
+  }
+
+  // Roots are the smallest vertices of their components, so they are met
+  // before the other vertices of their components.
+  std::vector<uint32_t> root_components(vertex_count);
+  uint32_t weak_component = 0;
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    const VertexId root = find_root(vertex);
+    if (root == vertex) {
+      root_components[vertex] = weak_component++;
+    }
+    labels_[vertex].weak_component = root_components[root];
+  }
+}
+
+}  // namespace graph
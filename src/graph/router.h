@@ -3,67 +3,108 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <execution>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "graph.h"
+#include "heap.h"
+#include "min_plus.h"
 
 namespace graph {
 
-template <typename Weight>
+// All-pairs shortest paths matrix. Cells keep weights as MatrixWeight
+// (usually narrower than the weight of the graph) and 32-bit edge ids, a
+// missing route or edge is marked by a sentinel value.
+template <typename Weight, typename MatrixWeight = float>
 class Router {
   using Graph = DirectedWeightedGraph<Weight>;
 
  public:
-  explicit Router(const Graph& graph);
+  static constexpr MatrixWeight NO_ROUTE =
+      std::numeric_limits<MatrixWeight>::infinity();
+  static constexpr uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max();
+
+  // Floyd-Warshall relaxes the whole matrix through every vertex, Dijkstra
+  // fills every row with a single-source search, which is much cheaper on
+  // sparse graphs. Both run in parallel.
+  enum class Algorithm { FLOYD_WARSHALL, DIJKSTRA };
+
+  struct RouteInternalData {
+    MatrixWeight weight = NO_ROUTE;
+    uint32_t prev_edge = NO_EDGE;
+  };
+
+  // Row-major vertex_count x vertex_count matrix.
+  using RoutesInternalData = std::vector<RouteInternalData>;
+
+  explicit Router(const Graph& graph,
+                  Algorithm algorithm = Algorithm::DIJKSTRA);
+  Router(const Graph& graph, RoutesInternalData routes_internal_data);
 
   struct RouteInfo {
     Weight weight;
     std::vector<EdgeId> edges;
   };
 
-  void Build() {
-    InitializeRoutesInternalData(graph_);
-    const size_t vertex_count = graph_.GetVertexCount();
-
-    for (VertexId vertex_through = 0; vertex_through < vertex_count;
-         ++vertex_through) {
-      RelaxRoutesInternalDataThroughVertex(vertex_count, vertex_through);
-    }
-  }
-
   std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+  const RoutesInternalData& GetRoutesInternalData() const;
 
- private:
-  struct RouteInternalData {
-    Weight weight;
-    std::optional<EdgeId> prev_edge;
-  };
+  // Repairs the routes after the edges were added to the graph, removed from
+  // it or changed their weights. Only the rows whose shortest paths use one
+  // of the edges are searched again, the others are relaxed through them.
+  void UpdateEdges(const std::vector<EdgeId>& edge_ids);
 
-  using RoutesInternalData =
-      std::vector<std::vector<std::optional<RouteInternalData>>>;
+ private:
+  static constexpr size_t BLOCK_SIZE = 64;
+  // Tiles of float weights are relaxed by the vector min-plus kernel.
+  static constexpr bool IS_MIN_PLUS_CELL =
+      std::is_same_v<MatrixWeight, float> &&
+      sizeof(RouteInternalData) == 2 * sizeof(float);
 
-  void InitializeRoutesInternalData(const Graph& graph) {
-    const size_t vertex_count = graph.GetVertexCount();
+  RouteInternalData& GetRouteInternalData(VertexId from, VertexId to) {
+    return routes_internal_data_[from * vertex_count_ + to];
+  }
 
-    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
-      routes_internal_data_[vertex][vertex] =
-          RouteInternalData{ZERO_WEIGHT, std::nullopt};
+  const RouteInternalData& GetRouteInternalData(VertexId from,
+                                                VertexId to) const {
+    return routes_internal_data_[from * vertex_count_ + to];
+  }
 
-      for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
-        const auto& edge = graph.GetEdge(edge_id);
+  void CheckGraph() const {
+    if (vertex_count_ >= NO_EDGE || graph_.GetEdgeCount() >= NO_EDGE) {
+      throw std::length_error("Graph is too large for 32-bit ids");
+    }
 
-        if (edge.weight < ZERO_WEIGHT) {
+    for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+      for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+        if (graph_.GetEdge(edge_id).weight < ZERO_WEIGHT) {
           throw std::domain_error("Edges' weights should be non-negative");
         }
+      }
+    }
+  }
+
+  void InitializeRoutesInternalData(const Graph& graph) {
+    for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+      GetRouteInternalData(vertex, vertex) =
+          RouteInternalData{MatrixWeight{}, NO_EDGE};
 
-        auto& route_internal_data = routes_internal_data_[vertex][edge.to];
-        if (!route_internal_data || route_internal_data->weight > edge.weight) {
-          route_internal_data = RouteInternalData{edge.weight, edge_id};
+      for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+        const auto& edge = graph.GetEdge(edge_id);
+        const auto weight = static_cast<MatrixWeight>(edge.weight);
+        auto& route_internal_data = GetRouteInternalData(vertex, edge.to);
+        if (route_internal_data.weight > weight) {
+          route_internal_data =
+              RouteInternalData{weight, static_cast<uint32_t>(edge_id)};
         }
       }
     }
@@ -72,66 +113,267 @@ class Router {
   void RelaxRoute(VertexId vertex_from, VertexId vertex_to,
                   const RouteInternalData& route_from,
                   const RouteInternalData& route_to) {
-    auto& route_relaxing = routes_internal_data_[vertex_from][vertex_to];
-    const Weight candidate_weight = route_from.weight + route_to.weight;
+    auto& route_relaxing = GetRouteInternalData(vertex_from, vertex_to);
+    const MatrixWeight candidate_weight = route_from.weight + route_to.weight;
 
-    if (!route_relaxing || candidate_weight < route_relaxing->weight) {
-      route_relaxing = {candidate_weight, route_to.prev_edge
+    if (candidate_weight < route_relaxing.weight) {
+      route_relaxing = {candidate_weight, route_to.prev_edge != NO_EDGE
                                               ? route_to.prev_edge
                                               : route_from.prev_edge};
     }
   }
 
-  void RelaxRoutesInternalDataThroughVertex(size_t vertex_count,
-                                            VertexId vertex_through) {
-    for (VertexId vertex_from = 0; vertex_from < vertex_count; ++vertex_from) {
-      if (const auto& route_from =
-              routes_internal_data_[vertex_from][vertex_through]) {
-        for (VertexId vertex_to = 0; vertex_to < vertex_count; ++vertex_to) {
-          if (const auto& route_to =
-                  routes_internal_data_[vertex_through][vertex_to]) {
-            RelaxRoute(vertex_from, vertex_to, *route_from, *route_to);
-          }
+  // Relaxes the tile (row_block, column_block) through every vertex of
+  // through_block.
+  void RelaxBlock(size_t row_block, size_t column_block, size_t through_block) {
+    const VertexId through_end =
+        std::min((through_block + 1) * BLOCK_SIZE, vertex_count_);
+    const VertexId from_end =
+        std::min((row_block + 1) * BLOCK_SIZE, vertex_count_);
+    const VertexId to_end =
+        std::min((column_block + 1) * BLOCK_SIZE, vertex_count_);
+
+    for (VertexId vertex_through = through_block * BLOCK_SIZE;
+         vertex_through < through_end; ++vertex_through) {
+      for (VertexId vertex_from = row_block * BLOCK_SIZE;
+           vertex_from < from_end; ++vertex_from) {
+        const auto& route_from =
+            GetRouteInternalData(vertex_from, vertex_through);
+        if (route_from.weight == NO_ROUTE) {
+          continue;
+        }
+
+        VertexId vertex_to = column_block * BLOCK_SIZE;
+        if constexpr (IS_MIN_PLUS_CELL) {
+          vertex_to += min_plus::RelaxRow(
+              &GetRouteInternalData(vertex_from, vertex_to),
+              &GetRouteInternalData(vertex_through, vertex_to),
+              to_end - vertex_to, route_from.weight, route_from.prev_edge);
+        }
+
+        for (; vertex_to < to_end; ++vertex_to) {
+          RelaxRoute(vertex_from, vertex_to, route_from,
+                     GetRouteInternalData(vertex_through, vertex_to));
+        }
+      }
+    }
+  }
+
+  // Blocked Floyd-Warshall: for every diagonal tile the tile itself is
+  // relaxed first, then the tiles of its row and column, then all the others.
+  // Tiles of the last two phases are independent and relaxed in parallel.
+  void RelaxRoutesInternalData() {
+    const size_t block_count = (vertex_count_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<size_t> blocks(block_count);
+    std::iota(blocks.begin(), blocks.end(), 0);
+
+    for (size_t through_block = 0; through_block < block_count;
+         ++through_block) {
+      RelaxBlock(through_block, through_block, through_block);
+
+      std::for_each(std::execution::par, blocks.begin(), blocks.end(),
+                    [this, through_block](size_t block) {
+                      if (block != through_block) {
+                        RelaxBlock(through_block, block, through_block);
+                        RelaxBlock(block, through_block, through_block);
+                      }
+                    });
+
+      std::for_each(std::execution::par, blocks.begin(), blocks.end(),
+                    [this, through_block, block_count](size_t row_block) {
+                      if (row_block == through_block) {
+                        return;
+                      }
+                      for (size_t column_block = 0; column_block < block_count;
+                           ++column_block) {
+                        if (column_block != through_block) {
+                          RelaxBlock(row_block, column_block, through_block);
+                        }
+                      }
+                    });
+    }
+  }
+
+  bool IsEdgeInGraph(EdgeId edge_id) const {
+    const auto edge_ids = graph_.GetIncidentEdges(graph_.GetEdge(edge_id).from);
+    return std::find(edge_ids.begin(), edge_ids.end(), edge_id) !=
+           edge_ids.end();
+  }
+
+  // Scratch arrays of the single-source searches of a thread.
+  struct SearchSpace {
+    std::vector<Weight> weights;
+    std::vector<bool> reached;
+    std::vector<bool> settled;
+    DaryHeap<std::pair<Weight, VertexId>, 4> queue;
+
+    void Reset(size_t vertex_count) {
+      weights.resize(vertex_count);
+      reached.assign(vertex_count, false);
+      settled.assign(vertex_count, false);
+      queue.Clear();
+    }
+  };
+
+  // Replaces the row of vertex_from with the result of a single-source search.
+  void SearchRoutesInternalData(VertexId vertex_from) {
+    const auto row =
+        routes_internal_data_.begin() + vertex_from * vertex_count_;
+    std::fill(row, row + vertex_count_, RouteInternalData{});
+
+    thread_local SearchSpace space;
+    space.Reset(vertex_count_);
+    auto& [weights, reached, settled, queue] = space;
+
+    weights[vertex_from] = ZERO_WEIGHT;
+    reached[vertex_from] = true;
+    queue.Push({ZERO_WEIGHT, vertex_from});
+
+    while (!queue.Empty()) {
+      const auto [weight, vertex] = queue.Pop();
+      if (settled[vertex]) {
+        continue;
+      }
+      settled[vertex] = true;
+      row[vertex].weight = static_cast<MatrixWeight>(weight);
+
+      for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+        const auto& edge = graph_.GetEdge(edge_id);
+        const Weight candidate_weight = weight + edge.weight;
+
+        if (!reached[edge.to] || candidate_weight < weights[edge.to]) {
+          reached[edge.to] = true;
+          weights[edge.to] = candidate_weight;
+          row[edge.to].prev_edge = static_cast<uint32_t>(edge_id);
+          queue.Push({candidate_weight, edge.to});
         }
       }
     }
   }
 
+  // Relaxes every route through a single edge, which is enough to repair the
+  // routes after the edge was added or became lighter.
+  void RelaxRoutesInternalData(EdgeId edge_id,
+                               const std::vector<VertexId>& vertices) {
+    const auto& edge = graph_.GetEdge(edge_id);
+
+    std::for_each(
+        std::execution::par, vertices.begin(), vertices.end(),
+        [this, &edge, edge_id](VertexId vertex_from) {
+          const auto& route_from = GetRouteInternalData(vertex_from, edge.from);
+          if (route_from.weight == NO_ROUTE) {
+            return;
+          }
+
+          const RouteInternalData route_through{
+              route_from.weight + static_cast<MatrixWeight>(edge.weight),
+              static_cast<uint32_t>(edge_id)};
+          for (VertexId vertex_to = 0; vertex_to < vertex_count_; ++vertex_to) {
+            const auto& route_to = GetRouteInternalData(edge.to, vertex_to);
+            if (route_to.weight != NO_ROUTE) {
+              RelaxRoute(vertex_from, vertex_to, route_through, route_to);
+            }
+          }
+        });
+  }
+
   static constexpr Weight ZERO_WEIGHT{};
   const Graph& graph_;
+  size_t vertex_count_;
   RoutesInternalData routes_internal_data_;
 };
 
-template <typename Weight>
-Router<Weight>::Router(const Graph& graph)
+template <typename Weight, typename MatrixWeight>
+Router<Weight, MatrixWeight>::Router(const Graph& graph, Algorithm algorithm)
+    : graph_(graph),
+      vertex_count_(graph.GetVertexCount()),
+      routes_internal_data_(vertex_count_ * vertex_count_) {
+  CheckGraph();
+
+  switch (algorithm) {
+    case Algorithm::FLOYD_WARSHALL:
+      InitializeRoutesInternalData(graph);
+      RelaxRoutesInternalData();
+      break;
+    case Algorithm::DIJKSTRA: {
+      std::vector<VertexId> vertices(vertex_count_);
+      std::iota(vertices.begin(), vertices.end(), 0);
+      std::for_each(
+          std::execution::par, vertices.begin(), vertices.end(),
+          [this](VertexId vertex) { SearchRoutesInternalData(vertex); });
+      break;
+    }
+  }
+}
+
+template <typename Weight, typename MatrixWeight>
+Router<Weight, MatrixWeight>::Router(const Graph& graph,
+                                     RoutesInternalData routes_internal_data)
     : graph_(graph),
-      routes_internal_data_(graph.GetVertexCount(),
-                            std::vector<std::optional<RouteInternalData>>(
-                                graph.GetVertexCount())) {
-  InitializeRoutesInternalData(graph);
+      vertex_count_(graph.GetVertexCount()),
+      routes_internal_data_(std::move(routes_internal_data)) {
+  if (routes_internal_data_.size() != vertex_count_ * vertex_count_) {
+    throw std::invalid_argument(
+        "Routes internal data does not match the graph");
+  }
+}
+
+template <typename Weight, typename MatrixWeight>
+const typename Router<Weight, MatrixWeight>::RoutesInternalData&
+Router<Weight, MatrixWeight>::GetRoutesInternalData() const {
+  return routes_internal_data_;
+}
+
+template <typename Weight, typename MatrixWeight>
+void Router<Weight, MatrixWeight>::UpdateEdges(
+    const std::vector<EdgeId>& edge_ids) {
+  if (graph_.GetVertexCount() != vertex_count_) {
+    throw std::invalid_argument("Vertices were added to the graph");
+  }
 
-  const size_t vertex_count = graph.GetVertexCount();
-  for (VertexId vertex_through = 0; vertex_through < vertex_count;
-       ++vertex_through) {
-    RelaxRoutesInternalDataThroughVertex(vertex_count, vertex_through);
+  const std::unordered_set<uint32_t> changed_edges(edge_ids.begin(),
+                                                   edge_ids.end());
+  std::vector<VertexId> vertices(vertex_count_);
+  std::iota(vertices.begin(), vertices.end(), 0);
+
+  std::for_each(std::execution::par, vertices.begin(), vertices.end(),
+                [this, &changed_edges](VertexId vertex_from) {
+                  const auto row = routes_internal_data_.begin() +
+                                   vertex_from * vertex_count_;
+                  if (std::any_of(row, row + vertex_count_,
+                                  [&changed_edges](const auto& route) {
+                                    return changed_edges.count(route.prev_edge);
+                                  })) {
+                    SearchRoutesInternalData(vertex_from);
+                  }
+                });
+
+  for (const EdgeId edge_id : edge_ids) {
+    if (IsEdgeInGraph(edge_id)) {
+      RelaxRoutesInternalData(edge_id, vertices);
+    }
   }
 }
 
-template <typename Weight>
-std::optional<typename Router<Weight>::RouteInfo> Router<Weight>::BuildRoute(
-    VertexId from, VertexId to) const {
-  const auto& route_internal_data = routes_internal_data_.at(from).at(to);
+template <typename Weight, typename MatrixWeight>
+std::optional<typename Router<Weight, MatrixWeight>::RouteInfo>
+Router<Weight, MatrixWeight>::BuildRoute(VertexId from, VertexId to) const {
+  if (from >= vertex_count_ || to >= vertex_count_) {
+    throw std::out_of_range("Vertex id is out of range");
+  }
+
+  const auto& route_internal_data = GetRouteInternalData(from, to);
 
-  if (!route_internal_data) {
+  if (route_internal_data.weight == NO_ROUTE) {
     return std::nullopt;
   }
 
-  const Weight weight = route_internal_data->weight;
+  const auto weight = static_cast<Weight>(route_internal_data.weight);
   std::vector<EdgeId> edges;
-  for (std::optional<EdgeId> edge_id = route_internal_data->prev_edge; edge_id;
-       edge_id = routes_internal_data_[from][graph_.GetEdge(*edge_id).from]
-                     ->prev_edge) {
-    edges.push_back(*edge_id);
+  for (uint32_t edge_id = route_internal_data.prev_edge; edge_id != NO_EDGE;
+       edge_id =
+           GetRouteInternalData(from, graph_.GetEdge(edge_id).from).prev_edge) {
+    edges.push_back(edge_id);
   }
 
   std::reverse(edges.begin(), edges.end());
@@ -139,4 +381,4 @@ std::optional<typename Router<Weight>::RouteInfo> Router<Weight>::BuildRoute(
   return RouteInfo{weight, std::move(edges)};
 }
 
-}  // end namespace graph
\ No newline at end of file
+}  // end namespace graph
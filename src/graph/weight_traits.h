@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace graph {
+
+// Non-negative fixed point number with Scale units in one. Sums and
+// comparisons are exact and the integer keys suit bucket and radix priority
+// queues.
+template <typename Integer, Integer Scale>
+class FixedPoint {
+ public:
+  static constexpr Integer SCALE = Scale;
+
+  constexpr FixedPoint() = default;
+  constexpr explicit FixedPoint(Integer value) : value_(value) {}
+
+  static FixedPoint FromDouble(double value) {
+    const double units = std::round(value * Scale);
+    if (units < 0) {
+      throw std::domain_error("Fixed point weights should be non-negative");
+    }
+    if (units > static_cast<double>(std::numeric_limits<Integer>::max())) {
+      throw std::out_of_range("Weight does not fit the fixed point type");
+    }
+    return FixedPoint(static_cast<Integer>(units));
+  }
+
+  constexpr Integer GetValue() const { return value_; }
+  double ToDouble() const { return static_cast<double>(value_) / Scale; }
+
+  // Saturates at the largest value instead of wrapping around.
+  constexpr FixedPoint operator+(FixedPoint other) const {
+    constexpr Integer MAX = std::numeric_limits<Integer>::max();
+    return FixedPoint(other.value_ > MAX - value_ ? MAX
+                                                : value_ + other.value_);
+  }
+  // Only for other not greater than this.
+  constexpr FixedPoint operator-(FixedPoint other) const {
+    return FixedPoint(value_ - other.value_);
+  }
+  constexpr bool operator<(FixedPoint other) const {
+    return value_ < other.value_;
+  }
+  constexpr bool operator==(FixedPoint other) const {
+    return value_ == other.value_;
+  }
+  constexpr bool operator!=(FixedPoint other) const {
+    return value_ != other.value_;
+  }
+
+ private:
+  Integer value_ = 0;
+};
+
+// Routers take their zero and largest weights from here and convert the
+// weights of the source graph with FromDouble.
+template <typename Weight>
+struct WeightTraits {
+  static constexpr Weight ZERO{};
+  static constexpr Weight MAX = std::numeric_limits<Weight>::max();
+
+  static Weight FromDouble(double weight) {
+    return static_cast<Weight>(weight);
+  }
+  static double ToDouble(Weight weight) { return static_cast<double>(weight); }
+};
+
+template <typename Integer, Integer Scale>
+struct WeightTraits<FixedPoint<Integer, Scale>> {
+  using Weight = FixedPoint<Integer, Scale>;
+
+  static constexpr Weight ZERO{};
+  static constexpr Weight MAX{std::numeric_limits<Integer>::max()};
+
+  static Weight FromDouble(double weight) { return Weight::FromDouble(weight); }
+  static double ToDouble(Weight weight) { return weight.ToDouble(); }
+  // Integer keys for radix priority queues.
+  static Integer ToKey(Weight weight) { return weight.GetValue(); }
+};
+
+}  // namespace graph
@@ -113,17 +113,13 @@ Node Handler::MakeMapNode(int request_id, TransportCatalogue &catalogue_,
       .Build();
 }
 
-Node Handler::MakeRouteNode(StatisticRequest &request,
-                            TransportCatalogue &catalogue,
-                            TransportRouter &routing) {
-  const auto &route =
-      GetRouteInfo(request.from, request.to, catalogue, routing);
-
+Node Handler::MakeRouteNode(int request_id,
+                            const std::optional<RouteInfo> &route) {
   if (!route) {
     return Builder{}
         .StartDict()
         .Key("request_id")
-        .Value(request.id)
+        .Value(request_id)
         .Key("error_message")
         .Value("not found")
         .EndDict()
@@ -138,7 +134,7 @@ Node Handler::MakeRouteNode(StatisticRequest &request,
   return Builder{}
       .StartDict()
       .Key("request_id")
-      .Value(request.id)
+      .Value(request_id)
       .Key("total_time")
       .Value(route->total_time)
       .Key("items")
@@ -147,15 +143,182 @@ Node Handler::MakeRouteNode(StatisticRequest &request,
       .Build();
 }
 
+std::vector<Node> Handler::MakeRouteNodes(
+    const std::vector<StatisticRequest> &stat_requests,
+    TransportCatalogue &catalogue, const TransportRouter &routing) {
+  std::vector<const StatisticRequest *> requests;
+  for (const StatisticRequest &request : stat_requests) {
+    if (request.type == "Route") {
+      requests.push_back(&request);
+    }
+  }
+
+  // Repeated requests are answered once and requests from one stop are
+  // answered together, so that a single search from the stop serves all of
+  // them.
+  std::unordered_map<std::pair<Stop *, Stop *>, std::vector<size_t>,
+                     DistancesHasher>
+      requests_by_stops;
+  std::vector<Node> nodes(requests.size());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    Stop *from = catalogue.GetStop(requests[i]->from);
+    Stop *to = catalogue.GetStop(requests[i]->to);
+    const auto from_stop = routing.GetRouterStop(from);
+    const auto to_stop = routing.GetRouterStop(to);
+    if (from_stop && to_stop) {
+      // Stops without a route between them are answered without a search.
+      if (routing.MayHaveRoute(from_stop->bus_wait_start,
+                               to_stop->bus_wait_start)) {
+        requests_by_stops[{from, to}].push_back(i);
+      } else {
+        nodes[i] = MakeRouteNode(requests[i]->id, std::nullopt);
+      }
+    } else if (from && from == to) {
+      // A stop left out of the compacted graph reaches only itself.
+      nodes[i] = MakeRouteNode(requests[i]->id, RouteInfo{});
+    } else {
+      nodes[i] = MakeRouteNode(requests[i]->id, std::nullopt);
+    }
+  }
+
+  std::unordered_map<Stop *, std::vector<Stop *>> destinations_by_origin;
+  for (const auto &[stops, indexes] : requests_by_stops) {
+    destinations_by_origin[stops.first].push_back(stops.second);
+  }
+
+  LOG(DEBUG) << "Route " << requests.size() << " requests from "
+             << destinations_by_origin.size() << " stops";
+  for (const auto &[from, to_stops] : destinations_by_origin) {
+    std::vector<VertexId> ends;
+    for (Stop *to : to_stops) {
+      ends.push_back(routing.GetRouterStop(to)->bus_wait_start);
+    }
+
+    const auto routes = routing.GetRouteInfos(
+        routing.GetRouterStop(from)->bus_wait_start, ends);
+    for (size_t j = 0; j < to_stops.size(); ++j) {
+      for (const size_t i : requests_by_stops.at({from, to_stops[j]})) {
+        nodes[i] = MakeRouteNode(requests[i]->id, routes[j]);
+      }
+    }
+  }
+
+  return nodes;
+}
+
+Node Handler::MakeRouteMatrixNode(StatisticRequest &request,
+                                  TransportCatalogue &catalogue,
+                                  const TransportRouter &routing) {
+  std::vector<std::optional<RouterStop>> to_stops;
+  std::vector<VertexId> ends;
+  for (const std::string &name : request.to_stops) {
+    to_stops.push_back(routing.GetRouterStop(catalogue.GetStop(name)));
+    if (to_stops.back()) {
+      ends.push_back(to_stops.back()->bus_wait_start);
+    }
+  }
+
+  Array total_times;
+  for (const std::string &name : request.from_stops) {
+    Stop *from = catalogue.GetStop(name);
+    const auto from_stop = routing.GetRouterStop(from);
+    Array row;
+
+    if (from_stop) {
+      const auto times = routing.GetTotalTimes(from_stop->bus_wait_start, ends);
+      auto time = times.begin();
+      for (const auto &to_stop : to_stops) {
+        if (to_stop && *time) {
+          row.emplace_back(**time);
+        } else {
+          row.emplace_back(nullptr);
+        }
+        if (to_stop) {
+          ++time;
+        }
+      }
+    } else {
+      // A stop left out of the compacted graph reaches only itself.
+      for (const std::string &to_name : request.to_stops) {
+        if (from && catalogue.GetStop(to_name) == from) {
+          row.emplace_back(0.0);
+        } else {
+          row.emplace_back(nullptr);
+        }
+      }
+    }
+
+    total_times.emplace_back(std::move(row));
+  }
+
+  return Builder{}
+      .StartDict()
+      .Key("request_id")
+      .Value(request.id)
+      .Key("total_times")
+      .Value(total_times)
+      .EndDict()
+      .Build();
+}
+
+Node Handler::MakeIsochroneNode(StatisticRequest &request,
+                                TransportCatalogue &catalogue,
+                                const TransportRouter &routing) {
+  Stop *from = catalogue.GetStop(request.from);
+
+  if (!from) {
+    return Builder{}
+        .StartDict()
+        .Key("request_id")
+        .Value(request.id)
+        .Key("error_message")
+        .Value("not found")
+        .EndDict()
+        .Build();
+  }
+
+  if (!(request.max_time >= 0)) {
+    return Builder{}
+        .StartDict()
+        .Key("request_id")
+        .Value(request.id)
+        .Key("error_message")
+        .Value("invalid max_time")
+        .EndDict()
+        .Build();
+  }
+
+  Array stops;
+  for (const auto &[stop, time] :
+       routing.GetReachableStops(from, request.max_time)) {
+    stops.emplace_back(Builder{}
+                           .StartDict()
+                           .Key("stop_name")
+                           .Value(stop->name)
+                           .Key("time")
+                           .Value(time)
+                           .EndDict()
+                           .Build());
+  }
+
+  return Builder{}
+      .StartDict()
+      .Key("request_id")
+      .Value(request.id)
+      .Key("stops")
+      .Value(stops)
+      .EndDict()
+      .Build();
+}
+
 void Handler::Queries(TransportCatalogue &catalogue,
                       std::vector<StatisticRequest> &stat_requests,
                       RenderSettings &render_settings,
-                      RoutingSettings &routing_settings) {
+                      const std::shared_future<TransportRouter> &router) {
   std::vector<Node> result;
-  TransportRouter router;
 
-  router.SetRoutingSettings(routing_settings);
-  router.BuildRouter(catalogue);
+  std::vector<Node> route_nodes;
+  auto route_node = route_nodes.begin();
 
   LOG(DEBUG) << "Start queries";
   for (StatisticRequest req : stat_requests) {
@@ -173,7 +336,21 @@ void Handler::Queries(TransportCatalogue &catalogue,
 
     } else if (req.type == "Route") {
       LOG(DEBUG) << "Route " << req.from << " to " << req.to << " " << req.id;
-      result.push_back(MakeRouteNode(req, catalogue, router));
+      if (route_nodes.empty()) {
+        route_nodes = MakeRouteNodes(stat_requests, catalogue, router.get());
+        route_node = route_nodes.begin();
+      }
+      result.push_back(std::move(*route_node++));
+
+    } else if (req.type == "RouteMatrix") {
+      LOG(DEBUG) << "RouteMatrix " << req.from_stops.size() << "x"
+                 << req.to_stops.size() << " " << req.id;
+      result.push_back(MakeRouteMatrixNode(req, catalogue, router.get()));
+
+    } else if (req.type == "Isochrone") {
+      LOG(DEBUG) << "Isochrone " << req.from << " " << req.max_time << " "
+                 << req.id;
+      result.push_back(MakeIsochroneNode(req, catalogue, router.get()));
     }
   }
 
@@ -239,15 +416,6 @@ void Handler::RenderMap(MapRenderer &map_catalogue,
   }
 }
 
-std::optional<RouteInfo> Handler::GetRouteInfo(std::string_view start,
-                                               std::string_view end,
-                                               TransportCatalogue &catalogue,
-                                               TransportRouter &routing) const {
-  return routing.GetRouteInfo(
-      routing.GetRouterStop(catalogue.GetStop(start))->bus_wait_start,
-      routing.GetRouterStop(catalogue.GetStop(end))->bus_wait_start);
-}
-
 std::vector<geo::Coordinates> Handler::GetStopsCoordinates(
     TransportCatalogue &catalogue_) const {
   std::vector<geo::Coordinates> coordinates;
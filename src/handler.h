@@ -1,5 +1,7 @@
 #pragma once
 
+#include <future>
+
 #include "catalogue.h"
 #include "json/builder.h"
 #include "renderer.h"
@@ -17,11 +19,6 @@ class Handler {
  public:
   Handler() = default;
 
-  std::optional<RouteInfo> GetRouteInfo(std::string_view start,
-                                        std::string_view end,
-                                        TransportCatalogue &catalogue,
-                                        TransportRouter &routing) const;
-
   std::vector<geo::Coordinates> GetStopsCoordinates(
       TransportCatalogue &catalogue_) const;
   std::vector<std::string_view> GetBusNames(
@@ -34,13 +31,21 @@ class Handler {
   Node MakeBusNode(int request_id, const BusInfo &query);
   Node MakeMapNode(int request_id, TransportCatalogue &catalogue,
                    RenderSettings render_settings);
-  Node MakeRouteNode(StatisticRequest &request, TransportCatalogue &catalogue,
-                     TransportRouter &routing);
+  Node MakeRouteNode(int request_id, const std::optional<RouteInfo> &route);
+  std::vector<Node> MakeRouteNodes(
+      const std::vector<StatisticRequest> &stat_requests,
+      TransportCatalogue &catalogue, const TransportRouter &routing);
+  Node MakeRouteMatrixNode(StatisticRequest &request,
+                           TransportCatalogue &catalogue,
+                           const TransportRouter &routing);
+  Node MakeIsochroneNode(StatisticRequest &request,
+                         TransportCatalogue &catalogue,
+                         const TransportRouter &routing);
 
   void Queries(TransportCatalogue &catalogue,
                std::vector<StatisticRequest> &stat_requests,
                RenderSettings &render_settings,
-               RoutingSettings &route_settings);
+               const std::shared_future<TransportRouter> &router);
 
   void RenderMap(MapRenderer &map_catalogue,
                  TransportCatalogue &catalogue_) const;
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <iostream>
 
+#include "benchmark.h"
 #include "handler.h"
 #include "log/easylogging++.h"
 #include "reader.h"
@@ -16,7 +19,8 @@ using namespace transport_catalogue::router;
 INITIALIZE_EASYLOGGINGPP
 
 void PrintUsage(std::ostream &stream = std::cerr) {
-  stream << "Usage: transport_catalogue [make_base|process_requests]\n"sv;
+  stream << "Usage: transport_catalogue "
+            "[make_base|process_requests|benchmark]\n"sv;
 }
 
 int main(int argc, char *argv[]) {
@@ -40,25 +44,64 @@ int main(int argc, char *argv[]) {
     Parser(cin).ProcessTransportCatalogue(transport_catalogue, render_settings,
                                           routing_settings,
                                           serialization_settings);
+    LOG(INFO) << "Start building router"sv;
+    TransportRouter transport_router;
+    transport_router.SetRoutingSettings(routing_settings);
+    try {
+      transport_router.BuildRouter(transport_catalogue);
+    } catch (const length_error &error) {
+      LOG(ERROR) << error.what();
+      return 1;
+    }
     LOG(INFO) << "Start serialization"sv;
     ofstream file(serialization_settings.file_name, ios::binary);
     CatalogueSerialization(transport_catalogue, render_settings,
-                           routing_settings, file);
+                           transport_router, file);
     LOG(INFO) << "Save to file "sv << serialization_settings.file_name;
     LOG(INFO) << "End serialization"sv;
   } else if (mode == "process_requests"sv) {
     LOG(INFO) << "Start process_requests"sv;
-    Parser(cin).ProcessRequests(stat_request, serialization_settings);
+    Parser parser(cin);
+    parser.ProcessRequests(stat_request, serialization_settings);
     ifstream file(serialization_settings.file_name, ios::binary);
     LOG(INFO) << "Start deserialization from file "sv
               << serialization_settings.file_name;
     Catalogue catalogue = CatalogueDeserialization(file);
     LOG(INFO) << "End deserialization"sv;
+    shared_future<TransportRouter> transport_router;
+    if (parser.HasUpdates()) {
+      // Updates change the catalogue, so they are applied before any request
+      // is answered.
+      LOG(INFO) << "Start updates"sv;
+      promise<TransportRouter> updated_router;
+      updated_router.set_value(parser.ProcessUpdates(catalogue));
+      transport_router = updated_router.get_future().share();
+      LOG(INFO) << "End updates"sv;
+    } else {
+      // The router is only needed for route requests. When there are any, it
+      // is built in the background while the other requests are answered.
+      const bool has_route_requests =
+          any_of(stat_request.begin(), stat_request.end(),
+                 [](const StatisticRequest &request) {
+                   return request.type == "Route"sv ||
+                          request.type == "RouteMatrix"sv ||
+                          request.type == "Isochrone"sv;
+                 });
+      transport_router = async(
+          has_route_requests ? launch::async : launch::deferred,
+          [&catalogue] { return TransportRouterDeserialization(catalogue); });
+    }
     Handler handler;
     handler.Queries(catalogue.transport_catalogue_, stat_request,
-                    catalogue.render_settings_, catalogue.routing_settings_);
+                    catalogue.render_settings_, transport_router);
     Print(handler.GetDocument(), cout);
     LOG(INFO) << "End process_requests"sv;
+  } else if (mode == "benchmark"sv) {
+    // Reads the same input as process_requests, the requests are ignored.
+    Parser(cin).ProcessRequests(stat_request, serialization_settings);
+    ifstream file(serialization_settings.file_name, ios::binary);
+    Catalogue catalogue = CatalogueDeserialization(file);
+    benchmark::QueueBenchmark(TransportRouterDeserialization(catalogue), cout);
   } else {
     LOG(ERROR) << "Invalid mode "sv << mode;
     PrintUsage();
@@ -84,8 +84,21 @@ void Parser::ProcessNodeTransportCatalogue(const Node &root,
       }
     }
 
+    // Stops are added along a Hilbert curve, so stops close on the map get
+    // close ids in the catalogue, the router graph and the database.
+    std::vector<Stop> catalogue_stops;
     for (auto stop : stops) {
-      catalogue.AddStop(ProcessNodeStop(stop));
+      catalogue_stops.push_back(ProcessNodeStop(stop));
+    }
+    std::stable_sort(catalogue_stops.begin(), catalogue_stops.end(),
+                     [](const Stop &left, const Stop &right) {
+                       return geo::GetHilbertIndex(
+                                  {left.latitude, left.longitude}) <
+                              geo::GetHilbertIndex(
+                                  {right.latitude, right.longitude});
+                     });
+    for (auto &stop : catalogue_stops) {
+      catalogue.AddStop(std::move(stop));
     }
 
     for (auto stop : stops) {
@@ -123,12 +136,29 @@ void Parser::ProcessNodeStatisticRequest(
             tmp_stat_request.from = tmp_node.AsDict().at("from").AsString();
             tmp_stat_request.to = tmp_node.AsDict().at("to").AsString();
 
+          } else if (tmp_stat_request.type == "Isochrone") {
+            tmp_stat_request.from = tmp_node.AsDict().at("from").AsString();
+            tmp_stat_request.to = "";
+            tmp_stat_request.max_time =
+                tmp_node.AsDict().at("max_time").AsDouble();
+
           } else {
             tmp_stat_request.from = "";
             tmp_stat_request.to = "";
           }
         }
 
+        tmp_stat_request.from_stops.clear();
+        tmp_stat_request.to_stops.clear();
+        if (tmp_stat_request.type == "RouteMatrix") {
+          for (const Node &stop : tmp_node.AsDict().at("from").AsArray()) {
+            tmp_stat_request.from_stops.push_back(stop.AsString());
+          }
+          for (const Node &stop : tmp_node.AsDict().at("to").AsArray()) {
+            tmp_stat_request.to_stops.push_back(stop.AsString());
+          }
+        }
+
         stat_request.push_back(tmp_stat_request);
       }
     }
@@ -225,6 +255,68 @@ void Parser::ProcessNodeRoutingSettings(
           node.AsDict().at("bus_wait_time").AsDouble();
       route_settings.bus_velocity = node.AsDict().at("bus_velocity").AsDouble();
 
+      if (node.AsDict().count("router_type")) {
+        const std::string &router_type =
+            node.AsDict().at("router_type").AsString();
+
+        if (router_type == "dijkstra") {
+          route_settings.router_type = router::RouterType::DIJKSTRA;
+        } else if (router_type == "all_pairs") {
+          route_settings.router_type = router::RouterType::ALL_PAIRS;
+        } else if (router_type == "contraction_hierarchies") {
+          route_settings.router_type =
+              router::RouterType::CONTRACTION_HIERARCHIES;
+        } else if (router_type == "astar") {
+          route_settings.router_type = router::RouterType::ASTAR;
+        } else if (router_type == "hub_labels") {
+          route_settings.router_type = router::RouterType::HUB_LABELS;
+        } else if (router_type == "alt") {
+          route_settings.router_type = router::RouterType::ALT;
+        } else {
+          std::cout << "unknown router type" << std::endl;
+        }
+      }
+
+      if (node.AsDict().count("graph_model")) {
+        const std::string &graph_model =
+            node.AsDict().at("graph_model").AsString();
+
+        if (graph_model == "stop_pairs") {
+          route_settings.graph_model = router::GraphModel::STOP_PAIRS;
+        } else if (graph_model == "bus_rides") {
+          route_settings.graph_model = router::GraphModel::BUS_RIDES;
+        } else if (graph_model == "stop_vertices") {
+          route_settings.graph_model = router::GraphModel::STOP_VERTICES;
+        } else {
+          std::cout << "unknown graph model" << std::endl;
+        }
+      }
+
+      if (node.AsDict().count("all_pairs_algorithm")) {
+        const std::string &all_pairs_algorithm =
+            node.AsDict().at("all_pairs_algorithm").AsString();
+
+        if (all_pairs_algorithm == "floyd_warshall") {
+          route_settings.all_pairs_algorithm =
+              router::AllPairsAlgorithm::FLOYD_WARSHALL;
+        } else if (all_pairs_algorithm == "dijkstra") {
+          route_settings.all_pairs_algorithm =
+              router::AllPairsAlgorithm::DIJKSTRA;
+        } else {
+          std::cout << "unknown all pairs algorithm" << std::endl;
+        }
+      }
+
+      if (node.AsDict().count("landmark_count")) {
+        route_settings.landmark_count =
+            node.AsDict().at("landmark_count").AsInt();
+      }
+
+      if (node.AsDict().count("compact_graph")) {
+        route_settings.compact_graph =
+            node.AsDict().at("compact_graph").AsBool();
+      }
+
     } catch (...) {
       std::cout << "unable to parse routing settings" << std::endl;
     }
@@ -250,6 +342,79 @@ void Parser::ProcessNodeSerializationSettings(
   }
 }
 
+void Parser::ProcessNodeUpdates(const Node &root,
+                                TransportCatalogue &catalogue,
+                                router::TransportRouter *router) {
+  std::vector<Node> buses, stops;
+
+  if (!root.IsArray()) {
+    std::cout << "update_requests is not an array" << std::endl;
+    return;
+  }
+
+  for (Node node : root.AsArray()) {
+    if (node.IsDict()) {
+      try {
+        if (node.AsDict().at("type").AsString() == "Bus") {
+          buses.push_back(node.AsDict());
+        } else if (node.AsDict().at("type").AsString() == "Stop") {
+          stops.push_back(node.AsDict());
+        } else {
+          std::cout << "update_requests are invalid" << std::endl;
+        }
+      } catch (...) {
+        std::cout << "update_requests does not have type value" << std::endl;
+      }
+    }
+  }
+
+  // Coordinates of a known stop are kept, only its distances change.
+  for (auto stop : stops) {
+    Stop new_stop = ProcessNodeStop(stop);
+    if (!catalogue.GetStop(new_stop.name)) {
+      catalogue.AddStop(std::move(new_stop));
+    }
+  }
+
+  for (auto stop : stops) {
+    std::vector<Distance> distances = ProcessNodeDistances(stop, catalogue);
+    distances.erase(std::remove_if(distances.begin(), distances.end(),
+                                   [](const Distance &distance) {
+                                     return !distance.end;
+                                   }),
+                    distances.end());
+
+    catalogue.SetDistance(distances);
+    if (router) {
+      for (const auto &distance : distances) {
+        router->UpdateDistance(catalogue, distance.start, distance.end);
+      }
+    }
+  }
+
+  // A known bus is replaced.
+  for (auto bus : buses) {
+    Bus new_bus = ProcessNodeBus(bus, catalogue);
+    if (std::count(new_bus.stops.begin(), new_bus.stops.end(), nullptr)) {
+      std::cout << "update bus has unknown stops" << std::endl;
+      continue;
+    }
+
+    const std::string name = new_bus.name;
+    if (Bus *old_bus = catalogue.GetBus(name)) {
+      if (router) {
+        router->RemoveBus(old_bus);
+      }
+      catalogue.RemoveBus(old_bus);
+    }
+
+    catalogue.AddBus(std::move(new_bus));
+    if (router) {
+      router->AddBus(catalogue, catalogue.GetBus(name));
+    }
+  }
+}
+
 void Parser::ProcessTransportCatalogue(
     TransportCatalogue &catalogue, renderer::RenderSettings &render_settings,
     router::RoutingSettings &routing_settings,
@@ -294,5 +459,29 @@ void Parser::ProcessRequests(
   }
 }
 
+bool Parser::HasUpdates() const {
+  return document.GetRoot().IsDict() &&
+         document.GetRoot().AsDict().count("update_requests");
+}
+
+// A compacted router can not be updated, so it is built again from the
+// updated catalogue.
+router::TransportRouter Parser::ProcessUpdates(
+    serialization::Catalogue &catalogue) {
+  const Node &root = document.GetRoot().AsDict().at("update_requests");
+
+  if (catalogue.routing_settings_.compact_graph) {
+    ProcessNodeUpdates(root, catalogue.transport_catalogue_, nullptr);
+    catalogue.transport_router_model_.reset();
+    return serialization::TransportRouterDeserialization(catalogue);
+  }
+
+  router::TransportRouter router =
+      serialization::TransportRouterDeserialization(catalogue);
+  ProcessNodeUpdates(root, catalogue.transport_catalogue_, &router);
+
+  return router;
+}
+
 }  // end namespace json
 }  // end namespace transport_catalogue
\ No newline at end of file
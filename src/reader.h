@@ -24,6 +24,9 @@ class Parser {
   void ProcessNodeSerializationSettings(
       const Node &node,
       serialization::SerializationSettings &serialization_set);
+  // A null router leaves the routing graph as it is.
+  void ProcessNodeUpdates(const Node &root, TransportCatalogue &catalogue,
+                          router::TransportRouter *router);
 
   void ProcessTransportCatalogue(
       TransportCatalogue &catalogue, renderer::RenderSettings &render_settings,
@@ -34,6 +37,11 @@ class Parser {
       std::vector<StatisticRequest> &stat_request,
       serialization::SerializationSettings &serialization_settings);
 
+  bool HasUpdates() const;
+  // Applies update_requests to the deserialized catalogue and returns its
+  // router with the same changes.
+  router::TransportRouter ProcessUpdates(serialization::Catalogue &catalogue);
+
   Stop ProcessNodeStop(Node &node);
   Bus ProcessNodeBus(Node &node, TransportCatalogue &catalogue);
   std::vector<Distance> ProcessNodeDistances(Node &node,
@@ -13,17 +13,114 @@ const RoutingSettings &TransportRouter::GetRoutingSettings() const {
 
 void TransportRouter::BuildRouter(TransportCatalogue &transport_catalogue) {
   SetGraph(transport_catalogue);
-  router_ = std::make_unique<Router<double>>(*graph_);
-  router_->Build();
+  BuildRouter();
+}
+
+// Single-source searches are made by every router type, so the Dijkstra
+// router is always built in addition to the router of the chosen type.
+void TransportRouter::BuildRouter() {
+  BuildDijkstraRouter();
+
+  switch (routing_settings_.router_type) {
+    case RouterType::ASTAR:
+      InitGeoHeuristic();
+      break;
+    case RouterType::DIJKSTRA:
+      break;
+    case RouterType::ALL_PAIRS:
+      if (graph_->GetVertexCount() > MAX_ALL_PAIRS_VERTEX_COUNT) {
+        throw std::length_error(
+            "Graph of " + std::to_string(graph_->GetVertexCount()) +
+            " vertices is too large for the all_pairs router, the limit is " +
+            std::to_string(MAX_ALL_PAIRS_VERTEX_COUNT));
+      }
+      router_ = MakeAllPairsRouter();
+      break;
+    case RouterType::CONTRACTION_HIERARCHIES:
+      contraction_hierarchy_ =
+          std::make_unique<ContractionHierarchy<double>>(*graph_);
+      break;
+    case RouterType::HUB_LABELS:
+      hub_labels_ = std::make_unique<HubLabels<double>>(*graph_);
+      break;
+    case RouterType::ALT:
+      landmarks_ = std::make_unique<Landmarks<SearchTime>>(
+          *graph_, routing_settings_.landmark_count);
+      break;
+  }
+}
+
+std::unique_ptr<Router<double>> TransportRouter::MakeAllPairsRouter() const {
+  return std::make_unique<Router<double>>(
+      *graph_, static_cast<Router<double>::Algorithm>(
+                   routing_settings_.all_pairs_algorithm));
+}
+
+void TransportRouter::BuildRouter(
+    Router<double>::RoutesInternalData routes_internal_data) {
+  BuildDijkstraRouter();
+  router_ = std::make_unique<Router<double>>(*graph_,
+                                             std::move(routes_internal_data));
+}
+
+void TransportRouter::BuildRouter(
+    ContractionHierarchy<double> contraction_hierarchy) {
+  BuildDijkstraRouter();
+  contraction_hierarchy_ = std::make_unique<ContractionHierarchy<double>>(
+      std::move(contraction_hierarchy));
+}
+
+void TransportRouter::BuildRouter(
+    HubLabels<double>::HubLabelsData hub_labels_data) {
+  BuildDijkstraRouter();
+  hub_labels_ =
+      std::make_unique<HubLabels<double>>(*graph_, std::move(hub_labels_data));
+}
+
+void TransportRouter::BuildRouter(
+    Landmarks<SearchTime>::LandmarksData landmarks_data) {
+  BuildDijkstraRouter();
+  landmarks_ =
+      std::make_unique<Landmarks<SearchTime>>(std::move(landmarks_data));
+}
+
+void TransportRouter::BuildDijkstraRouter() {
+  csr_graph_ = std::make_unique<CsrGraph<SearchTime>>(*graph_);
+  dijkstra_router_ = std::make_unique<SearchRouter>(*csr_graph_);
+
+  if (!reachability_labels_) {
+    reachability_labels_ = std::make_unique<ReachabilityLabels>(*graph_);
+  }
 }
 
 const DirectedWeightedGraph<double> &TransportRouter::GetGraph() const {
   return *graph_;
 }
 const Router<double> &TransportRouter::GetRouter() const { return *router_; }
-const std::variant<StopEdge, BusEdge> &TransportRouter::GetEdge(
-    EdgeId id) const {
-  return edge_id_to_edge_.at(id);
+const SearchRouter &TransportRouter::GetDijkstraRouter() const {
+  return *dijkstra_router_;
+}
+const ContractionHierarchy<double> &TransportRouter::GetContractionHierarchy()
+    const {
+  return *contraction_hierarchy_;
+}
+const HubLabels<double> &TransportRouter::GetHubLabels() const {
+  return *hub_labels_;
+}
+const Landmarks<SearchTime> &TransportRouter::GetLandmarks() const {
+  return *landmarks_;
+}
+const ReachabilityLabels &TransportRouter::GetReachabilityLabels() const {
+  return *reachability_labels_;
+}
+std::variant<StopEdge, BusEdge> TransportRouter::GetEdge(EdgeId id) const {
+  const double time = graph_->GetEdge(id).weight;
+
+  if (edge_is_bus_.at(id)) {
+    return BusEdge{bus_names_[edge_name_indexes_[id]], edge_span_counts_[id],
+                   time};
+  }
+  return StopEdge{stop_names_[edge_name_indexes_[id]], time};
 }
 
 std::optional<RouterStop> TransportRouter::GetRouterStop(Stop *stop) const {
@@ -34,39 +131,153 @@ std::optional<RouterStop> TransportRouter::GetRouterStop(Stop *stop) const {
   }
 }
 
+bool TransportRouter::MayHaveRoute(VertexId start, VertexId end) const {
+  return reachability_labels_->MayHaveRoute(start, end);
+}
+
 std::optional<RouteInfo> TransportRouter::GetRouteInfo(
     VertexId start, graph::VertexId end) const {
-  const auto &route_info = router_->BuildRoute(start, end);
-  if (route_info) {
-    RouteInfo result;
-    result.total_time = route_info->weight;
-
-    for (const auto edge : route_info->edges) {
-      result.edges.emplace_back(GetEdge(edge));
+  switch (routing_settings_.router_type) {
+    case RouterType::DIJKSTRA:
+      return MakeRouteInfo(dijkstra_router_->BuildRoute(start, end));
+    case RouterType::ALL_PAIRS:
+      return MakeRouteInfo(router_->BuildRoute(start, end));
+    case RouterType::CONTRACTION_HIERARCHIES:
+      return MakeRouteInfo(contraction_hierarchy_->BuildRoute(start, end));
+    case RouterType::HUB_LABELS:
+      return MakeRouteInfo(hub_labels_->BuildRoute(start, end));
+    case RouterType::ASTAR: {
+      const geo::CartesianPoint target = vertex_points_.at(end);
+      return MakeRouteInfo(dijkstra_router_->BuildRoute(
+          start, end, [this, target](VertexId vertex) {
+            return WeightTraits<SearchTime>::FromDouble(
+                min_time_per_meter_ *
+                geo::CalculateChordDistance(vertex_points_[vertex], target));
+          }));
     }
+    case RouterType::ALT:
+      return MakeRouteInfo(dijkstra_router_->BuildRoute(
+          start, end, [this, end](VertexId vertex) {
+            return landmarks_->GetLowerBound(vertex, end);
+          }));
+  }
+
+  return std::nullopt;
+}
 
-    return result;
+std::vector<std::optional<RouteInfo>> TransportRouter::GetRouteInfos(
+    VertexId start, const std::vector<VertexId> &ends) const {
+  std::vector<std::optional<RouteInfo>> route_infos;
+  route_infos.reserve(ends.size());
 
+  // A single destination is found faster by a search that stops there.
+  const RouterType router_type = routing_settings_.router_type;
+  if (ends.size() > 1 && (router_type == RouterType::DIJKSTRA ||
+                          router_type == RouterType::ASTAR ||
+                          router_type == RouterType::ALT)) {
+    const auto routes_tree = dijkstra_router_->BuildRoutesTree(start);
+    for (const VertexId end : ends) {
+      route_infos.push_back(MakeRouteInfo(routes_tree.BuildRoute(end)));
+    }
   } else {
-    return std::nullopt;
+    for (const VertexId end : ends) {
+      route_infos.push_back(GetRouteInfo(start, end));
+    }
   }
+
+  return route_infos;
+}
+
+std::vector<std::optional<double>> TransportRouter::GetTotalTimes(
+    VertexId start, const std::vector<VertexId> &ends) const {
+  std::vector<std::optional<double>> total_times;
+  total_times.reserve(ends.size());
+
+  switch (routing_settings_.router_type) {
+    case RouterType::DIJKSTRA:
+    case RouterType::ASTAR:
+    case RouterType::ALT: {
+      // One search tree answers every destination of the origin.
+      const auto routes_tree = dijkstra_router_->BuildRoutesTree(start);
+      for (const VertexId end : ends) {
+        total_times.push_back(MakeTotalTime(routes_tree.BuildRoute(end)));
+      }
+      break;
+    }
+    case RouterType::ALL_PAIRS:
+      for (const VertexId end : ends) {
+        total_times.push_back(MakeTotalTime(router_->BuildRoute(start, end)));
+      }
+      break;
+    case RouterType::CONTRACTION_HIERARCHIES:
+      for (const VertexId end : ends) {
+        total_times.push_back(
+            MakeTotalTime(contraction_hierarchy_->BuildRoute(start, end)));
+      }
+      break;
+    case RouterType::HUB_LABELS:
+      // The labels give the time without restoring the route.
+      for (const VertexId end : ends) {
+        total_times.push_back(hub_labels_->GetWeight(start, end));
+      }
+      break;
+  }
+
+  return total_times;
+}
+
+std::vector<std::pair<Stop *, double>> TransportRouter::GetReachableStops(
+    Stop *start, double max_time) const {
+  std::vector<std::pair<Stop *, double>> reachable_stops;
+
+  // A stop left out of the compacted graph reaches only itself.
+  if (!stop_to_router_.count(start)) {
+    reachable_stops.emplace_back(start, 0);
+    return reachable_stops;
+  }
+
+  // Times beyond the range of search times do not bound the search.
+  constexpr SearchTime MAX_TIME = WeightTraits<SearchTime>::MAX;
+  const SearchTime time_bound =
+      max_time < WeightTraits<SearchTime>::ToDouble(MAX_TIME)
+          ? WeightTraits<SearchTime>::FromDouble(max_time)
+          : MAX_TIME;
+
+  const auto routes_tree = dijkstra_router_->BuildRoutesTree(
+      stop_to_router_.at(start).bus_wait_start, time_bound);
+  for (const auto &[stop, router_stop] : stop_to_router_) {
+    if (const auto time = routes_tree.GetWeight(router_stop.bus_wait_start)) {
+      reachable_stops.emplace_back(stop,
+                                   WeightTraits<SearchTime>::ToDouble(*time));
+    }
+  }
+
+  std::sort(reachable_stops.begin(), reachable_stops.end(),
+            [](const auto &left, const auto &right) {
+              return std::tie(left.second, left.first->name) <
+                     std::tie(right.second, right.first->name);
+            });
+
+  return reachable_stops;
 }
 
 const std::unordered_map<Stop *, RouterStop> &TransportRouter::GetStopVertex()
     const {
   return stop_to_router_;
 }
-const std::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>>
-    &TransportRouter::GetEdgeId() const {
-  return edge_id_to_edge_;
+
+const std::vector<Stop *> &TransportRouter::GetVertexStops() const {
+  return vertex_stops_;
 }
 
 std::deque<Stop *> TransportRouter::GetStops(
     TransportCatalogue &transport_catalogue) {
   std::deque<Stop *> stops_ptr;
 
-  for (auto [_, stop_ptr] : transport_catalogue.GetStopNames()) {
-    stops_ptr.push_back(stop_ptr);
+  // Vertices follow the order of the stops in the catalogue, which keeps
+  // stops close on the map close in the graph.
+  for (const auto &stop : transport_catalogue.GetStops()) {
+    stops_ptr.push_back(transport_catalogue.GetStop(stop.name));
   }
 
   return stops_ptr;
@@ -76,21 +287,25 @@ std::deque<Bus *> TransportRouter::GetBuses(
     TransportCatalogue &transport_catalogue) {
   std::deque<Bus *> buses_ptr;
 
-  for (auto [_, bus_ptr] : transport_catalogue.GetBusNames()) {
-    buses_ptr.push_back(bus_ptr);
+  for (const auto &bus : transport_catalogue.GetBuses()) {
+    buses_ptr.push_back(transport_catalogue.GetBus(bus.name));
   }
 
   return buses_ptr;
 }
 
+// The stop vertices graph model boards and alights buses at the same vertex
+// of a stop, the other models have a wait edge between two vertices.
 void TransportRouter::SetStops(const std::deque<Stop *> &stops) {
+  const bool has_wait_edges =
+      routing_settings_.graph_model != GraphModel::STOP_VERTICES;
   size_t i = 0;
 
   for (const auto stop : stops) {
     VertexId first = i++;
-    VertexId second = i++;
+    VertexId second = has_wait_edges ? i++ : first;
 
-    stop_to_router_[stop] = RouterStop{first, second};
+    SetRouterStop(stop, RouterStop{first, second});
   }
 }
 
@@ -99,30 +314,506 @@ void TransportRouter::AddEdgeStop() {
     EdgeId id = graph_->AddEdge(Edge<double>{
         num.bus_wait_start, num.bus_wait_end, routing_settings_.bus_wait_time});
 
-    edge_id_to_edge_[id] =
-        StopEdge{stop->name, routing_settings_.bus_wait_time};
+    SetEdgeInfo(id, false,
+                GetNameIndex(stop->name, stop_names_, stop_name_indexes_), 0);
   }
 }
 
 void TransportRouter::AddEdgeBus(TransportCatalogue &transport_catalogue) {
+  std::vector<EdgeId> edge_ids;
+
   for (auto bus : GetBuses(transport_catalogue)) {
-    ParseBus(bus->stops.begin(), bus->stops.end(), transport_catalogue, bus);
+    AddBusEdges(bus, ParseBus(transport_catalogue, bus), edge_ids);
+  }
+}
+
+TransportRouter::BusEdges TransportRouter::ParseBus(
+    const TransportCatalogue &transport_catalogue, const Bus *bus) const {
+  BusEdges bus_edges;
+
+  ParseBus(bus->stops.begin(), bus->stops.end(), transport_catalogue, bus,
+           bus_edges);
+
+  if (!bus->is_round_trip) {
+    ParseBus(bus->stops.rbegin(), bus->stops.rend(), transport_catalogue, bus,
+             bus_edges);
+  }
+
+  return bus_edges;
+}
+
+// Bus rides model: every stop of a bus route gets its own ride vertex. A
+// passenger boards from the stop to the ride vertex, rides along the chain of
+// ride vertices and alights back to a stop, so the number of edges is linear
+// in the route length.
+void TransportRouter::AddEdgeBusRides(TransportCatalogue &transport_catalogue) {
+  VertexId ride_vertex = 2 * stop_to_router_.size();
+  std::vector<EdgeId> edge_ids;
+
+  for (auto bus : GetBuses(transport_catalogue)) {
+    SetRideVertexStops(bus, ride_vertex);
+    AddBusEdges(bus, ParseBusRides(transport_catalogue, bus, ride_vertex),
+                edge_ids);
+    ride_vertex += bus->stops.size();
+  }
+}
+
+// The ride vertex of a stop of the bus stands at that stop.
+void TransportRouter::SetRideVertexStops(const Bus *bus,
+                                         VertexId first_ride_vertex) {
+  for (size_t i = 0; i < bus->stops.size(); ++i) {
+    SetVertexStop(first_ride_vertex + i, bus->stops[i]);
+  }
+}
+
+TransportRouter::BusEdges TransportRouter::ParseBusRides(
+    const TransportCatalogue &transport_catalogue, const Bus *bus,
+    VertexId first_ride_vertex) const {
+  const size_t stops_count = bus->stops.size();
+  BusEdges bus_edges;
+
+  for (size_t i = 0; i < stops_count; ++i) {
+    const VertexId ride_vertex = first_ride_vertex + i;
+    const RouterStop &router_stop = stop_to_router_.at(bus->stops[i]);
+
+    if (i + 1 < stops_count) {
+      bus_edges.push_back(
+          {Edge<double>{router_stop.bus_wait_end, ride_vertex, 0},
+           BusEdge{bus->name, 0, 0}});
+    }
+
+    if (i > 0) {
+      const double time = GetBusTime(transport_catalogue.GetDistanceStops(
+          bus->stops[i - 1], bus->stops[i]));
 
-    if (!bus->is_round_trip) {
-      ParseBus(bus->stops.rbegin(), bus->stops.rend(), transport_catalogue,
-               bus);
+      bus_edges.push_back({Edge<double>{ride_vertex - 1, ride_vertex, time},
+                           BusEdge{bus->name, 1, time}});
+      bus_edges.push_back(
+          {Edge<double>{ride_vertex, router_stop.bus_wait_start, 0},
+           BusEdge{bus->name, 0, 0}});
     }
   }
+
+  return bus_edges;
 }
 
 void TransportRouter::SetGraph(TransportCatalogue &transport_catalogue) {
   const auto stops_ptr_size = GetStops(transport_catalogue).size();
+  size_t vertex_count =
+      routing_settings_.graph_model == GraphModel::STOP_VERTICES
+          ? stops_ptr_size
+          : 2 * stops_ptr_size;
+
+  if (routing_settings_.graph_model == GraphModel::BUS_RIDES) {
+    for (auto bus : GetBuses(transport_catalogue)) {
+      vertex_count += bus->stops.size();
+    }
+  }
 
-  graph_ = std::make_unique<DirectedWeightedGraph<double>>(2 * stops_ptr_size);
+  graph_ = std::make_unique<DirectedWeightedGraph<double>>(vertex_count);
+  reachability_labels_.reset();
 
   SetStops(GetStops(transport_catalogue));
-  AddEdgeStop();
-  AddEdgeBus(transport_catalogue);
+
+  switch (routing_settings_.graph_model) {
+    case GraphModel::STOP_PAIRS:
+      AddEdgeStop();
+      AddEdgeBus(transport_catalogue);
+      break;
+    case GraphModel::BUS_RIDES:
+      AddEdgeStop();
+      AddEdgeBusRides(transport_catalogue);
+      break;
+    case GraphModel::STOP_VERTICES:
+      AddEdgeBus(transport_catalogue);
+      break;
+  }
+
+  if (routing_settings_.compact_graph) {
+    CompactGraph();
+  }
+}
+
+// Stops no bus goes through are left out of the graph together with their
+// wait edges, and of the parallel edges between two vertices only the fastest
+// one is kept. The remaining vertices are numbered densely in their order.
+void TransportRouter::CompactGraph() {
+  const size_t vertex_count = graph_->GetVertexCount();
+  const size_t edge_count = graph_->GetEdgeCount();
+
+  std::vector<bool> is_kept(vertex_count, false);
+  for (EdgeId id = 0; id < edge_count; ++id) {
+    if (edge_is_bus_[id]) {
+      is_kept[graph_->GetEdge(id).from] = true;
+      is_kept[graph_->GetEdge(id).to] = true;
+    }
+  }
+  for (const auto &[_, router_stop] : stop_to_router_) {
+    const bool is_served = is_kept[router_stop.bus_wait_start] ||
+                           is_kept[router_stop.bus_wait_end];
+    is_kept[router_stop.bus_wait_start] = is_served;
+    is_kept[router_stop.bus_wait_end] = is_served;
+  }
+
+  std::vector<VertexId> vertex_ids(vertex_count);
+  size_t kept_vertex_count = 0;
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    if (is_kept[vertex]) {
+      vertex_ids[vertex] = kept_vertex_count++;
+    }
+  }
+
+  std::vector<EdgeId> edge_ids;
+  for (EdgeId id = 0; id < edge_count; ++id) {
+    const auto &edge = graph_->GetEdge(id);
+    if (is_kept[edge.from] && is_kept[edge.to]) {
+      edge_ids.push_back(id);
+    }
+  }
+
+  // After a stable sort by ends and weight the first edge of every pair of
+  // ends is the fastest one added first.
+  auto get_ends = [this](EdgeId id) {
+    const auto &edge = graph_->GetEdge(id);
+    return std::make_pair(edge.from, edge.to);
+  };
+  std::stable_sort(edge_ids.begin(), edge_ids.end(),
+                   [this, &get_ends](EdgeId left, EdgeId right) {
+                     return std::make_pair(get_ends(left),
+                                           graph_->GetEdge(left).weight) <
+                            std::make_pair(get_ends(right),
+                                           graph_->GetEdge(right).weight);
+                   });
+  edge_ids.erase(std::unique(edge_ids.begin(), edge_ids.end(),
+                             [&get_ends](EdgeId left, EdgeId right) {
+                               return get_ends(left) == get_ends(right);
+                             }),
+                 edge_ids.end());
+  std::sort(edge_ids.begin(), edge_ids.end());
+
+  auto graph =
+      std::make_unique<DirectedWeightedGraph<double>>(kept_vertex_count);
+  const auto edge_is_bus = std::exchange(edge_is_bus_, {});
+  const auto edge_name_indexes = std::exchange(edge_name_indexes_, {});
+  const auto edge_span_counts = std::exchange(edge_span_counts_, {});
+
+  for (const EdgeId id : edge_ids) {
+    const auto &edge = graph_->GetEdge(id);
+    const EdgeId kept_id = graph->AddEdge(Edge<double>{
+        vertex_ids[edge.from], vertex_ids[edge.to], edge.weight});
+
+    SetEdgeInfo(kept_id, edge_is_bus[id], edge_name_indexes[id],
+                edge_span_counts[id]);
+  }
+
+  const auto vertex_stops = std::exchange(vertex_stops_, {});
+  for (VertexId vertex = 0; vertex < vertex_stops.size(); ++vertex) {
+    if (is_kept[vertex]) {
+      SetVertexStop(vertex_ids[vertex], vertex_stops[vertex]);
+    }
+  }
+
+  const auto stop_to_router = std::exchange(stop_to_router_, {});
+  for (const auto &[stop, router_stop] : stop_to_router) {
+    if (is_kept[router_stop.bus_wait_start]) {
+      SetRouterStop(stop, RouterStop{vertex_ids[router_stop.bus_wait_start],
+                                     vertex_ids[router_stop.bus_wait_end]});
+    }
+  }
+
+  LOG(DEBUG) << "Compact graph from " << vertex_count << " vertices and "
+             << edge_count << " edges to " << graph->GetVertexCount()
+             << " vertices and " << graph->GetEdgeCount() << " edges";
+  graph_ = std::move(graph);
+}
+
+void TransportRouter::SetGraph(DirectedWeightedGraph<double> graph) {
+  graph_ = std::make_unique<DirectedWeightedGraph<double>>(std::move(graph));
+  reachability_labels_.reset();
+}
+
+void TransportRouter::SetReachabilityLabels(
+    ReachabilityLabels reachability_labels) {
+  reachability_labels_ =
+      std::make_unique<ReachabilityLabels>(std::move(reachability_labels));
+}
+
+void TransportRouter::SetRouterStop(Stop *stop, RouterStop router_stop) {
+  stop_to_router_[stop] = router_stop;
+  SetVertexStop(router_stop.bus_wait_start, stop);
+  SetVertexStop(router_stop.bus_wait_end, stop);
+}
+
+void TransportRouter::SetVertexStop(VertexId vertex, Stop *stop) {
+  if (vertex >= vertex_stops_.size()) {
+    vertex_stops_.resize(vertex + 1, nullptr);
+  }
+  vertex_stops_[vertex] = stop;
+}
+
+void TransportRouter::SetEdge(EdgeId id, std::variant<StopEdge, BusEdge> edge) {
+  if (std::holds_alternative<BusEdge>(edge)) {
+    const auto &bus_edge = std::get<BusEdge>(edge);
+    SetEdgeInfo(id, true,
+                GetNameIndex(bus_edge.name, bus_names_, bus_name_indexes_),
+                bus_edge.span_count);
+  } else {
+    SetEdgeInfo(
+        id, false,
+        GetNameIndex(std::get<StopEdge>(edge).name, stop_names_,
+                     stop_name_indexes_),
+        0);
+  }
+}
+
+uint32_t TransportRouter::GetNameIndex(
+    std::string_view name, std::vector<std::string_view> &names,
+    std::unordered_map<std::string_view, uint32_t> &indexes) {
+  const auto [it, inserted] =
+      indexes.emplace(name, static_cast<uint32_t>(names.size()));
+  if (inserted) {
+    names.push_back(name);
+  }
+  return it->second;
+}
+
+void TransportRouter::SetEdgeInfo(EdgeId id, bool is_bus_edge,
+                                  uint32_t name_index, size_t span_count) {
+  if (id >= edge_is_bus_.size()) {
+    edge_is_bus_.resize(id + 1);
+    edge_name_indexes_.resize(id + 1);
+    edge_span_counts_.resize(id + 1);
+  }
+
+  edge_is_bus_[id] = is_bus_edge;
+  edge_name_indexes_[id] = name_index;
+  edge_span_counts_[id] = static_cast<uint32_t>(span_count);
+}
+
+// Every edge is at least as slow as the fastest edge per metre of straight
+// line, so the straight line distance to the target gives an admissible and
+// consistent A* heuristic.
+void TransportRouter::InitGeoHeuristic() {
+  const size_t vertex_count = graph_->GetVertexCount();
+  vertex_points_.assign(vertex_count, {});
+  min_time_per_meter_ = 0;
+
+  for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+    const Stop *stop =
+        vertex < vertex_stops_.size() ? vertex_stops_[vertex] : nullptr;
+    if (!stop) {
+      // Databases written before ride vertices had stops.
+      LOG(WARNING) << "Vertex " << vertex << " has no position, A* searches "
+                   << "run without a heuristic";
+      return;
+    }
+    vertex_points_[vertex] =
+        geo::ToCartesian({stop->latitude, stop->longitude});
+  }
+
+  min_time_per_meter_ = std::numeric_limits<double>::infinity();
+
+  for (EdgeId id = 0; id < graph_->GetEdgeCount(); ++id) {
+    const auto &edge = graph_->GetEdge(id);
+    const double distance = geo::CalculateChordDistance(
+        vertex_points_[edge.from], vertex_points_[edge.to]);
+
+    if (distance > 0) {
+      min_time_per_meter_ =
+          std::min(min_time_per_meter_, edge.weight / distance);
+    }
+  }
+
+  if (min_time_per_meter_ == std::numeric_limits<double>::infinity()) {
+    min_time_per_meter_ = 0;
+  }
+
+  min_time_per_meter_ *= HEURISTIC_SAFETY_FACTOR;
+  LOG(DEBUG) << "A* heuristic of " << min_time_per_meter_
+             << " minutes per metre";
+}
+
+void TransportRouter::UpdateDistance(
+    const TransportCatalogue &transport_catalogue, const Stop *from,
+    const Stop *to) {
+  CheckUpdatable();
+  std::vector<EdgeId> changed_edges;
+
+  for (const auto [_, bus] : transport_catalogue.GetBusNames()) {
+    for (size_t i = 1; i < bus->stops.size(); ++i) {
+      if ((bus->stops[i - 1] == from && bus->stops[i] == to) ||
+          (bus->stops[i - 1] == to && bus->stops[i] == from)) {
+        UpdateBusEdges(transport_catalogue, bus, changed_edges);
+        break;
+      }
+    }
+  }
+
+  LOG(DEBUG) << "Update distance " << from->name << " to " << to->name
+             << " changed " << changed_edges.size() << " edges";
+  RepairRouter(changed_edges, false);
+}
+
+void TransportRouter::AddBus(const TransportCatalogue &transport_catalogue,
+                             const Bus *bus) {
+  CheckUpdatable();
+  std::vector<EdgeId> changed_edges;
+  bool vertices_added = false;
+
+  for (Stop *stop : bus->stops) {
+    if (stop_to_router_.count(stop)) {
+      continue;
+    }
+    vertices_added = true;
+
+    if (routing_settings_.graph_model == GraphModel::STOP_VERTICES) {
+      const VertexId vertex = graph_->AddVertex();
+      SetRouterStop(stop, RouterStop{vertex, vertex});
+      continue;
+    }
+
+    const RouterStop router_stop{graph_->AddVertex(), graph_->AddVertex()};
+    const EdgeId id = graph_->AddEdge(
+        Edge<double>{router_stop.bus_wait_start, router_stop.bus_wait_end,
+                     routing_settings_.bus_wait_time});
+
+    SetRouterStop(stop, router_stop);
+    SetEdgeInfo(id, false,
+                GetNameIndex(stop->name, stop_names_, stop_name_indexes_), 0);
+    changed_edges.push_back(id);
+  }
+
+  switch (routing_settings_.graph_model) {
+    case GraphModel::STOP_PAIRS:
+    case GraphModel::STOP_VERTICES:
+      AddBusEdges(bus, ParseBus(transport_catalogue, bus), changed_edges);
+      break;
+    case GraphModel::BUS_RIDES: {
+      const VertexId first_ride_vertex = graph_->GetVertexCount();
+      for (size_t i = 0; i < bus->stops.size(); ++i) {
+        graph_->AddVertex();
+      }
+      vertices_added = vertices_added || !bus->stops.empty();
+      SetRideVertexStops(bus, first_ride_vertex);
+      AddBusEdges(bus,
+                  ParseBusRides(transport_catalogue, bus, first_ride_vertex),
+                  changed_edges);
+      break;
+    }
+  }
+
+  LOG(DEBUG) << "Add bus " << bus->name << " with " << changed_edges.size()
+             << " edges";
+  RepairRouter(changed_edges, vertices_added);
+}
+
+void TransportRouter::RemoveBus(const Bus *bus) {
+  CheckUpdatable();
+  const std::vector<EdgeId> changed_edges = GetBusEdges(bus);
+
+  for (const EdgeId id : changed_edges) {
+    graph_->RemoveEdge(id);
+  }
+
+  LOG(DEBUG) << "Remove bus " << bus->name << " with " << changed_edges.size()
+             << " edges";
+  RepairRouter(changed_edges, false);
+}
+
+// Compaction drops the edges of a bus that other buses are faster on, so the
+// edges of a bus can not be found again.
+void TransportRouter::CheckUpdatable() const {
+  if (routing_settings_.compact_graph) {
+    throw std::logic_error("Compacted graph can not be updated");
+  }
+}
+
+std::vector<EdgeId> TransportRouter::GetBusEdges(const Bus *bus) const {
+  std::vector<EdgeId> bus_edges;
+
+  const auto bus_name_index = bus_name_indexes_.find(bus->name);
+  if (bus_name_index == bus_name_indexes_.end()) {
+    return bus_edges;
+  }
+
+  for (VertexId vertex = 0; vertex < graph_->GetVertexCount(); ++vertex) {
+    for (const EdgeId id : graph_->GetIncidentEdges(vertex)) {
+      if (edge_is_bus_[id] &&
+          edge_name_indexes_[id] == bus_name_index->second) {
+        bus_edges.push_back(id);
+      }
+    }
+  }
+
+  std::sort(bus_edges.begin(), bus_edges.end());
+
+  return bus_edges;
+}
+
+void TransportRouter::AddBusEdges(const Bus *bus, const BusEdges &bus_edges,
+                                  std::vector<EdgeId> &changed_edges) {
+  const uint32_t name_index =
+      GetNameIndex(bus->name, bus_names_, bus_name_indexes_);
+
+  for (const auto &[edge, bus_edge] : bus_edges) {
+    const EdgeId id = graph_->AddEdge(edge);
+
+    SetEdgeInfo(id, true, name_index, bus_edge.span_count);
+    changed_edges.push_back(id);
+  }
+}
+
+// Edges of a bus are added in the order they are parsed in, so parsing the
+// bus again gives the new weights of its edges in the order of their ids.
+void TransportRouter::UpdateBusEdges(
+    const TransportCatalogue &transport_catalogue, const Bus *bus,
+    std::vector<EdgeId> &changed_edges) {
+  const std::vector<EdgeId> edge_ids = GetBusEdges(bus);
+  if (edge_ids.empty()) {
+    return;
+  }
+
+  const BusEdges bus_edges =
+      routing_settings_.graph_model == GraphModel::BUS_RIDES
+          ? ParseBusRides(transport_catalogue, bus,
+                          graph_->GetEdge(edge_ids.front()).to)
+          : ParseBus(transport_catalogue, bus);
+
+  if (bus_edges.size() != edge_ids.size()) {
+    throw std::logic_error("Stops of the bus have changed");
+  }
+
+  for (size_t i = 0; i < edge_ids.size(); ++i) {
+    if (graph_->GetEdge(edge_ids[i]).weight != bus_edges[i].first.weight) {
+      graph_->SetEdgeWeight(edge_ids[i], bus_edges[i].first.weight);
+      changed_edges.push_back(edge_ids[i]);
+    }
+  }
+}
+
+// Dijkstra and A* searches only need the frozen copy of the graph to be made
+// again, the all-pairs router repairs the affected routes unless the graph got
+// new vertices, contraction hierarchies have to be built anew.
+void TransportRouter::RepairRouter(const std::vector<EdgeId> &changed_edges,
+                                   bool vertices_added) {
+  if (changed_edges.empty() && !vertices_added) {
+    return;
+  }
+  reachability_labels_.reset();
+
+  switch (routing_settings_.router_type) {
+    case RouterType::ALL_PAIRS:
+      BuildDijkstraRouter();
+      if (vertices_added) {
+        router_ = MakeAllPairsRouter();
+      } else {
+        router_->UpdateEdges(changed_edges);
+      }
+      break;
+    default:
+      BuildRouter();
+      break;
+  }
 }
 
 Edge<double> TransportRouter::MakeEdgeBus(Stop *start, Stop *end,
@@ -131,10 +822,18 @@ Edge<double> TransportRouter::MakeEdgeBus(Stop *start, Stop *end,
 
   result.from = stop_to_router_.at(start).bus_wait_end;
   result.to = stop_to_router_.at(end).bus_wait_start;
-  result.weight = distance * 1.0 / (routing_settings_.bus_velocity * KM / HR);
+  result.weight = GetBusTime(distance);
+  // Without wait edges the wait at the stop is a part of boarding the bus.
+  if (routing_settings_.graph_model == GraphModel::STOP_VERTICES) {
+    result.weight += routing_settings_.bus_wait_time;
+  }
   LOG(DEBUG) << "Make edge for bus " << start->name << " to " << end->name
              << " with weight " << result.weight;
   return result;
 }
 
+double TransportRouter::GetBusTime(const double distance) const {
+  return distance * 1.0 / (routing_settings_.bus_velocity * KM / HR);
+}
+
 }  // end namespace transport_catalogue::router
\ No newline at end of file
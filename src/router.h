@@ -2,10 +2,18 @@
 
 #include <deque>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 
 #include "catalogue.h"
 #include "domain.h"
+#include "graph/contraction_hierarchy.h"
+#include "graph/dijkstra.h"
+#include "graph/hub_labels.h"
+#include "graph/landmarks.h"
+#include "graph/reachability.h"
 #include "graph/router.h"
 
 namespace transport_catalogue::router {
@@ -15,54 +23,212 @@ using namespace graph;
 
 static const uint16_t KM = 1000;
 static const uint16_t HR = 60;
+static const double HEURISTIC_SAFETY_FACTOR = 0.999;
+// The all-pairs table is stored in a single protobuf message, which can not
+// exceed 2 GB. An entry takes at most 9 bytes, so 12000 vertices give 1.3 GB.
+static const size_t MAX_ALL_PAIRS_VERTEX_COUNT = 12000;
+
+// Times of the single-source searches: minutes in 1/100 s units. Integer
+// times let the searches use a radix heap.
+using SearchTime = FixedPoint<uint32_t, 6000>;
+using SearchRouter = DijkstraRouter<SearchTime, RadixHeapPolicy>;
 
 class TransportRouter {
  public:
+  using BusEdges = std::vector<std::pair<Edge<double>, BusEdge>>;
+
   void SetRoutingSettings(RoutingSettings routing_settings);
   const RoutingSettings &GetRoutingSettings() const;
 
   void BuildRouter(TransportCatalogue &transport_catalogue);
+  void BuildRouter();
+  void BuildRouter(Router<double>::RoutesInternalData routes_internal_data);
+  void BuildRouter(ContractionHierarchy<double> contraction_hierarchy);
+  void BuildRouter(HubLabels<double>::HubLabelsData hub_labels_data);
+  void BuildRouter(Landmarks<SearchTime>::LandmarksData landmarks_data);
+
+  // Dynamic updates, the catalogue should already contain the change. Only
+  // the edges of the affected buses are changed and the router is repaired.
+  // A router built with compact_graph throws std::logic_error.
+  void UpdateDistance(const TransportCatalogue &transport_catalogue,
+                      const Stop *from, const Stop *to);
+  void AddBus(const TransportCatalogue &transport_catalogue, const Bus *bus);
+  void RemoveBus(const Bus *bus);
 
   const DirectedWeightedGraph<double> &GetGraph() const;
   const Router<double> &GetRouter() const;
-  const std::variant<StopEdge, BusEdge> &GetEdge(EdgeId id) const;
+  const SearchRouter &GetDijkstraRouter() const;
+  const ContractionHierarchy<double> &GetContractionHierarchy() const;
+  const HubLabels<double> &GetHubLabels() const;
+  const Landmarks<SearchTime> &GetLandmarks() const;
+  const ReachabilityLabels &GetReachabilityLabels() const;
+  std::variant<StopEdge, BusEdge> GetEdge(EdgeId id) const;
 
   std::optional<RouterStop> GetRouterStop(Stop *stop) const;
+  // Answers in constant time, false when there is surely no route.
+  bool MayHaveRoute(VertexId start, VertexId end) const;
   std::optional<RouteInfo> GetRouteInfo(VertexId start, VertexId end) const;
+  std::vector<std::optional<RouteInfo>> GetRouteInfos(
+      VertexId start, const std::vector<VertexId> &ends) const;
+  std::vector<std::optional<double>> GetTotalTimes(
+      VertexId start, const std::vector<VertexId> &ends) const;
+  // Stops reachable from start within max_time with their earliest arrival
+  // times, the closest stops first. max_time should be non-negative.
+  std::vector<std::pair<Stop *, double>> GetReachableStops(
+      Stop *start, double max_time) const;
 
   const std::unordered_map<Stop *, RouterStop> &GetStopVertex() const;
-  const std::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>> &GetEdgeId()
-      const;
+  const std::vector<Stop *> &GetVertexStops() const;
 
   std::deque<Stop *> GetStops(TransportCatalogue &transport_catalogue);
   std::deque<Bus *> GetBuses(TransportCatalogue &transport_catalogue);
 
   void AddEdgeStop();
   void AddEdgeBus(TransportCatalogue &transport_catalogue);
+  void AddEdgeBusRides(TransportCatalogue &transport_catalogue);
 
   void SetStops(const std::deque<Stop *> &stops);
   void SetGraph(TransportCatalogue &transport_catalogue);
+  void SetGraph(DirectedWeightedGraph<double> graph);
+  void SetRouterStop(Stop *stop, RouterStop router_stop);
+  void SetEdge(EdgeId id, std::variant<StopEdge, BusEdge> edge);
+  void SetVertexStop(VertexId vertex, Stop *stop);
+  void SetReachabilityLabels(ReachabilityLabels reachability_labels);
 
   Edge<double> MakeEdgeBus(Stop *start, Stop *end, const double distance) const;
+  double GetBusTime(const double distance) const;
 
   template <typename Iterator>
   void ParseBus(Iterator first, Iterator last,
-                const TransportCatalogue &transport_catalogue, const Bus *bus);
+                const TransportCatalogue &transport_catalogue, const Bus *bus,
+                BusEdges &bus_edges) const;
+  BusEdges ParseBus(const TransportCatalogue &transport_catalogue,
+                    const Bus *bus) const;
+  BusEdges ParseBusRides(const TransportCatalogue &transport_catalogue,
+                         const Bus *bus, VertexId first_ride_vertex) const;
 
  private:
+  void BuildDijkstraRouter();
+  std::unique_ptr<Router<double>> MakeAllPairsRouter() const;
+  void InitGeoHeuristic();
+  void SetRideVertexStops(const Bus *bus, VertexId first_ride_vertex);
+  void CompactGraph();
+  void CheckUpdatable() const;
+
+  uint32_t GetNameIndex(
+      std::string_view name, std::vector<std::string_view> &names,
+      std::unordered_map<std::string_view, uint32_t> &indexes);
+  void SetEdgeInfo(EdgeId id, bool is_bus_edge, uint32_t name_index,
+                   size_t span_count);
+
+  std::vector<EdgeId> GetBusEdges(const Bus *bus) const;
+  void AddBusEdges(const Bus *bus, const BusEdges &bus_edges,
+                   std::vector<EdgeId> &changed_edges);
+  void UpdateBusEdges(const TransportCatalogue &transport_catalogue,
+                      const Bus *bus, std::vector<EdgeId> &changed_edges);
+  void RepairRouter(const std::vector<EdgeId> &changed_edges,
+                    bool vertices_added);
+
+  template <typename GraphRouteInfo>
+  std::optional<RouteInfo> MakeRouteInfo(
+      const std::optional<GraphRouteInfo> &route_info) const;
+  template <typename GraphRouteInfo>
+  std::optional<double> MakeTotalTime(
+      const std::optional<GraphRouteInfo> &route_info) const;
+
   std::unordered_map<Stop *, RouterStop> stop_to_router_;
-  std::unordered_map<EdgeId, std::variant<StopEdge, BusEdge>> edge_id_to_edge_;
+
+  // Edge metadata indexed by EdgeId: whether the edge is a bus ride or a wait
+  // at a stop, the index of its bus or stop name and the number of stops the
+  // ride spans. The time of an edge is its weight in the graph.
+  std::vector<bool> edge_is_bus_;
+  std::vector<uint32_t> edge_name_indexes_;
+  std::vector<uint32_t> edge_span_counts_;
+  std::vector<std::string_view> stop_names_;
+  std::vector<std::string_view> bus_names_;
+  std::unordered_map<std::string_view, uint32_t> stop_name_indexes_;
+  std::unordered_map<std::string_view, uint32_t> bus_name_indexes_;
+  // The stop every vertex stands at, nullptr when it is not known.
+  std::vector<Stop *> vertex_stops_;
 
   std::unique_ptr<DirectedWeightedGraph<double>> graph_;
   std::unique_ptr<Router<double>> router_;
+  std::unique_ptr<CsrGraph<SearchTime>> csr_graph_;
+  std::unique_ptr<SearchRouter> dijkstra_router_;
+  std::unique_ptr<ContractionHierarchy<double>> contraction_hierarchy_;
+  std::unique_ptr<HubLabels<double>> hub_labels_;
+  std::unique_ptr<Landmarks<SearchTime>> landmarks_;
+  // Belong to the graph, they are dropped when the graph changes and built
+  // again with the Dijkstra router.
+  std::unique_ptr<ReachabilityLabels> reachability_labels_;
+
+  std::vector<geo::CartesianPoint> vertex_points_;
+  double min_time_per_meter_ = 0;
 
   RoutingSettings routing_settings_;
 };
 
+template <typename GraphRouteInfo>
+std::optional<RouteInfo> TransportRouter::MakeRouteInfo(
+    const std::optional<GraphRouteInfo> &route_info) const {
+  if (route_info) {
+    RouteInfo result;
+
+    for (const auto edge : route_info->edges) {
+      auto item = GetEdge(edge);
+      result.total_time +=
+          std::visit([](const auto &item) { return item.time; }, item);
+
+      // Bus edges of the stop vertices graph model include the wait at the
+      // stop of boarding, it is shown as a wait item of its own.
+      if (routing_settings_.graph_model == GraphModel::STOP_VERTICES &&
+          std::holds_alternative<BusEdge>(item)) {
+        const VertexId stop_vertex = graph_->GetEdge(edge).from;
+        result.edges.push_back(StopEdge{vertex_stops_[stop_vertex]->name,
+                                        routing_settings_.bus_wait_time});
+        std::get<BusEdge>(item).time -= routing_settings_.bus_wait_time;
+      }
+
+      // Consecutive edges of one bus are boarding, riding and alighting
+      // edges of the bus rides graph model and make up a single trip.
+      if (std::holds_alternative<BusEdge>(item) && !result.edges.empty() &&
+          std::holds_alternative<BusEdge>(result.edges.back()) &&
+          std::get<BusEdge>(result.edges.back()).name ==
+              std::get<BusEdge>(item).name) {
+        auto &trip = std::get<BusEdge>(result.edges.back());
+        trip.span_count += std::get<BusEdge>(item).span_count;
+        trip.time += std::get<BusEdge>(item).time;
+      } else {
+        result.edges.push_back(item);
+      }
+    }
+
+    return result;
+
+  } else {
+    return std::nullopt;
+  }
+}
+
+template <typename GraphRouteInfo>
+std::optional<double> TransportRouter::MakeTotalTime(
+    const std::optional<GraphRouteInfo> &route_info) const {
+  if (!route_info) {
+    return std::nullopt;
+  }
+
+  double total_time = 0;
+  for (const auto edge : route_info->edges) {
+    total_time += graph_->GetEdge(edge).weight;
+  }
+
+  return total_time;
+}
+
 template <typename Iterator>
 void TransportRouter::ParseBus(Iterator first, Iterator last,
                                const TransportCatalogue &transport_catalogue,
-                               const Bus *bus) {
+                               const Bus *bus, BusEdges &bus_edges) const {
   for (auto it = first; it != last; ++it) {
     size_t distance = 0;
     size_t span = 0;
@@ -71,10 +237,8 @@ void TransportRouter::ParseBus(Iterator first, Iterator last,
       distance += transport_catalogue.GetDistanceStops(*prev(it2), *it2);
       ++span;
 
-      EdgeId id = graph_->AddEdge(MakeEdgeBus(*it, *it2, distance));
-
-      edge_id_to_edge_[id] =
-          BusEdge{bus->name, span, graph_->GetEdge(id).weight};
+      const Edge<double> edge = MakeEdgeBus(*it, *it2, distance);
+      bus_edges.push_back({edge, BusEdge{bus->name, span, edge.weight}});
     }
   }
 }
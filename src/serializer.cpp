@@ -263,6 +263,17 @@ transport_catalogue_model::RoutingSettings RoutingSettingsSerialization(
 
   routing_settings_model.set_bus_wait_time(routing_settings.bus_wait_time);
   routing_settings_model.set_bus_velocity(routing_settings.bus_velocity);
+  routing_settings_model.set_router_type(
+      static_cast<transport_catalogue_model::RouterType>(
+          routing_settings.router_type));
+  routing_settings_model.set_graph_model(
+      static_cast<transport_catalogue_model::GraphModel>(
+          routing_settings.graph_model));
+  routing_settings_model.set_all_pairs_algorithm(
+      static_cast<transport_catalogue_model::AllPairsAlgorithm>(
+          routing_settings.all_pairs_algorithm));
+  routing_settings_model.set_landmark_count(routing_settings.landmark_count);
+  routing_settings_model.set_compact_graph(routing_settings.compact_graph);
 
   return routing_settings_model;
 }
@@ -273,14 +284,506 @@ domain::RoutingSettings RoutingSettingsDeserialization(
 
   routing_settings.bus_wait_time = routing_settings_model.bus_wait_time();
   routing_settings.bus_velocity = routing_settings_model.bus_velocity();
+  routing_settings.router_type =
+      static_cast<domain::RouterType>(routing_settings_model.router_type());
+  routing_settings.graph_model =
+      static_cast<domain::GraphModel>(routing_settings_model.graph_model());
+  routing_settings.all_pairs_algorithm =
+      static_cast<domain::AllPairsAlgorithm>(
+          routing_settings_model.all_pairs_algorithm());
+  routing_settings.landmark_count = routing_settings_model.landmark_count();
+  routing_settings.compact_graph = routing_settings_model.compact_graph();
 
   return routing_settings;
 }
 
+transport_catalogue_model::Graph GraphSerialization(
+    const graph::DirectedWeightedGraph<double> &graph) {
+  transport_catalogue_model::Graph graph_model;
+
+  graph_model.set_vertex_count(graph.GetVertexCount());
+
+  for (graph::EdgeId id = 0; id < graph.GetEdgeCount(); ++id) {
+    const auto &edge = graph.GetEdge(id);
+    transport_catalogue_model::Edge edge_model;
+
+    edge_model.set_from(edge.from);
+    edge_model.set_to(edge.to);
+    edge_model.set_weight(edge.weight);
+
+    *graph_model.add_edges() = std::move(edge_model);
+  }
+
+  return graph_model;
+}
+
+graph::DirectedWeightedGraph<double> GraphDeserialization(
+    const transport_catalogue_model::Graph &graph_model) {
+  graph::DirectedWeightedGraph<double> graph(graph_model.vertex_count());
+
+  for (const auto &edge_model : graph_model.edges()) {
+    graph.AddEdge({edge_model.from(), edge_model.to(), edge_model.weight()});
+  }
+
+  return graph;
+}
+
+transport_catalogue_model::RoutesInternalData RoutesInternalDataSerialization(
+    const graph::Router<double>::RoutesInternalData &routes_internal_data) {
+  using Router = graph::Router<double>;
+  transport_catalogue_model::RoutesInternalData routes_internal_data_model;
+
+  routes_internal_data_model.mutable_weights()->Reserve(
+      routes_internal_data.size());
+  routes_internal_data_model.mutable_prev_edges()->Reserve(
+      routes_internal_data.size());
+  for (const auto &route : routes_internal_data) {
+    routes_internal_data_model.add_weights(route.weight);
+    routes_internal_data_model.add_prev_edges(
+        route.prev_edge != Router::NO_EDGE ? route.prev_edge + 1 : 0);
+  }
+
+  return routes_internal_data_model;
+}
+
+graph::Router<double>::RoutesInternalData RoutesInternalDataDeserialization(
+    const transport_catalogue_model::RoutesInternalData
+        &routes_internal_data_model,
+    size_t vertex_count) {
+  using Router = graph::Router<double>;
+
+  if (static_cast<size_t>(routes_internal_data_model.weights_size()) !=
+          vertex_count * vertex_count ||
+      static_cast<size_t>(routes_internal_data_model.prev_edges_size()) !=
+          vertex_count * vertex_count) {
+    throw std::runtime_error("routes internal data does not match the graph");
+  }
+
+  Router::RoutesInternalData routes_internal_data(vertex_count * vertex_count);
+
+  for (size_t i = 0; i < routes_internal_data.size(); ++i) {
+    const uint32_t prev_edge = routes_internal_data_model.prev_edges(i);
+
+    routes_internal_data[i] = Router::RouteInternalData{
+        routes_internal_data_model.weights(i),
+        prev_edge ? prev_edge - 1 : Router::NO_EDGE};
+  }
+
+  return routes_internal_data;
+}
+
+transport_catalogue_model::ContractionHierarchy
+ContractionHierarchySerialization(
+    const graph::ContractionHierarchy<double> &contraction_hierarchy) {
+  using HierarchyEdge = graph::ContractionHierarchy<double>::HierarchyEdge;
+  transport_catalogue_model::ContractionHierarchy contraction_hierarchy_model;
+
+  for (const size_t rank : contraction_hierarchy.GetRanks()) {
+    contraction_hierarchy_model.add_ranks(rank);
+  }
+
+  for (const HierarchyEdge &edge : contraction_hierarchy.GetEdges()) {
+    transport_catalogue_model::HierarchyEdge edge_model;
+
+    edge_model.set_from(edge.from);
+    edge_model.set_to(edge.to);
+    edge_model.set_weight(edge.weight);
+
+    if (edge.edge != graph::ContractionHierarchy<double>::NO_EDGE) {
+      edge_model.set_edge(edge.edge + 1);
+    } else {
+      edge_model.set_first(edge.first);
+      edge_model.set_second(edge.second);
+    }
+
+    *contraction_hierarchy_model.add_edges() = std::move(edge_model);
+  }
+
+  return contraction_hierarchy_model;
+}
+
+graph::ContractionHierarchy<double> ContractionHierarchyDeserialization(
+    const transport_catalogue_model::ContractionHierarchy
+        &contraction_hierarchy_model) {
+  using HierarchyEdge = graph::ContractionHierarchy<double>::HierarchyEdge;
+
+  std::vector<size_t> ranks(contraction_hierarchy_model.ranks().begin(),
+                            contraction_hierarchy_model.ranks().end());
+  std::vector<HierarchyEdge> edges;
+  edges.reserve(contraction_hierarchy_model.edges_size());
+
+  for (const auto &edge_model : contraction_hierarchy_model.edges()) {
+    HierarchyEdge edge{edge_model.from(), edge_model.to(), edge_model.weight()};
+
+    if (edge_model.edge()) {
+      edge.edge = edge_model.edge() - 1;
+    } else {
+      edge.first = edge_model.first();
+      edge.second = edge_model.second();
+    }
+
+    edges.push_back(edge);
+  }
+
+  return graph::ContractionHierarchy<double>(std::move(ranks),
+                                             std::move(edges));
+}
+
+transport_catalogue_model::Labels LabelsSerialization(
+    const graph::HubLabels<double>::Labels &labels) {
+  using HubLabels = graph::HubLabels<double>;
+  transport_catalogue_model::Labels labels_model;
+
+  for (size_t vertex = 0; vertex + 1 < labels.offsets.size(); ++vertex) {
+    labels_model.add_counts(labels.offsets[vertex + 1] -
+                            labels.offsets[vertex]);
+  }
+
+  labels_model.mutable_hubs()->Reserve(labels.labels.size());
+  labels_model.mutable_weights()->Reserve(labels.labels.size());
+  labels_model.mutable_edges()->Reserve(labels.labels.size());
+  for (const auto &label : labels.labels) {
+    labels_model.add_hubs(label.hub);
+    labels_model.add_weights(label.weight);
+    labels_model.add_edges(label.edge != HubLabels::NO_EDGE ? label.edge + 1
+                                                            : 0);
+  }
+
+  return labels_model;
+}
+
+graph::HubLabels<double>::Labels LabelsDeserialization(
+    const transport_catalogue_model::Labels &labels_model) {
+  using HubLabels = graph::HubLabels<double>;
+
+  if (labels_model.weights_size() != labels_model.hubs_size() ||
+      labels_model.edges_size() != labels_model.hubs_size()) {
+    throw std::runtime_error("hub labels are corrupted");
+  }
+
+  HubLabels::Labels labels;
+  labels.offsets.reserve(labels_model.counts_size() + 1);
+  labels.offsets.push_back(0);
+  for (const uint32_t count : labels_model.counts()) {
+    labels.offsets.push_back(labels.offsets.back() + count);
+  }
+
+  if (labels.offsets.back() != static_cast<size_t>(labels_model.hubs_size())) {
+    throw std::runtime_error("hub labels are corrupted");
+  }
+
+  labels.labels.reserve(labels_model.hubs_size());
+  for (int i = 0; i < labels_model.hubs_size(); ++i) {
+    const uint32_t edge = labels_model.edges(i);
+    labels.labels.push_back({labels_model.hubs(i), labels_model.weights(i),
+                             edge ? edge - 1 : HubLabels::NO_EDGE});
+  }
+
+  return labels;
+}
+
+transport_catalogue_model::HubLabels HubLabelsSerialization(
+    const graph::HubLabels<double>::HubLabelsData &hub_labels_data) {
+  transport_catalogue_model::HubLabels hub_labels_model;
+
+  for (const graph::VertexId hub : hub_labels_data.hubs) {
+    hub_labels_model.add_hubs(hub);
+  }
+  *hub_labels_model.mutable_out_labels() =
+      LabelsSerialization(hub_labels_data.out_labels);
+  *hub_labels_model.mutable_in_labels() =
+      LabelsSerialization(hub_labels_data.in_labels);
+
+  return hub_labels_model;
+}
+
+graph::HubLabels<double>::HubLabelsData HubLabelsDeserialization(
+    const transport_catalogue_model::HubLabels &hub_labels_model) {
+  graph::HubLabels<double>::HubLabelsData hub_labels_data;
+
+  hub_labels_data.hubs.assign(hub_labels_model.hubs().begin(),
+                              hub_labels_model.hubs().end());
+  hub_labels_data.out_labels =
+      LabelsDeserialization(hub_labels_model.out_labels());
+  hub_labels_data.in_labels =
+      LabelsDeserialization(hub_labels_model.in_labels());
+
+  return hub_labels_data;
+}
+
+transport_catalogue_model::Landmarks LandmarksSerialization(
+    const graph::Landmarks<transport_catalogue::router::SearchTime>::
+        LandmarksData &landmarks_data) {
+  transport_catalogue_model::Landmarks landmarks_model;
+
+  for (const graph::VertexId landmark : landmarks_data.landmarks) {
+    landmarks_model.add_landmarks(landmark);
+  }
+
+  landmarks_model.mutable_weights_from()->Reserve(
+      landmarks_data.weights_from.size());
+  for (const auto weight : landmarks_data.weights_from) {
+    landmarks_model.add_weights_from(weight.GetValue());
+  }
+
+  landmarks_model.mutable_weights_to()->Reserve(
+      landmarks_data.weights_to.size());
+  for (const auto weight : landmarks_data.weights_to) {
+    landmarks_model.add_weights_to(weight.GetValue());
+  }
+
+  return landmarks_model;
+}
+
+graph::Landmarks<transport_catalogue::router::SearchTime>::LandmarksData
+LandmarksDeserialization(
+    const transport_catalogue_model::Landmarks &landmarks_model) {
+  using transport_catalogue::router::SearchTime;
+  graph::Landmarks<SearchTime>::LandmarksData landmarks_data;
+
+  landmarks_data.landmarks.assign(landmarks_model.landmarks().begin(),
+                                  landmarks_model.landmarks().end());
+
+  landmarks_data.weights_from.reserve(landmarks_model.weights_from_size());
+  for (const uint32_t weight : landmarks_model.weights_from()) {
+    landmarks_data.weights_from.emplace_back(weight);
+  }
+
+  landmarks_data.weights_to.reserve(landmarks_model.weights_to_size());
+  for (const uint32_t weight : landmarks_model.weights_to()) {
+    landmarks_data.weights_to.emplace_back(weight);
+  }
+
+  return landmarks_data;
+}
+
+transport_catalogue_model::ReachabilityLabels ReachabilityLabelsSerialization(
+    const graph::ReachabilityLabels &reachability_labels) {
+  transport_catalogue_model::ReachabilityLabels reachability_labels_model;
+
+  for (const auto &label : reachability_labels.GetLabels()) {
+    reachability_labels_model.add_components(label.component);
+    reachability_labels_model.add_weak_components(label.weak_component);
+  }
+
+  return reachability_labels_model;
+}
+
+graph::ReachabilityLabels ReachabilityLabelsDeserialization(
+    const transport_catalogue_model::ReachabilityLabels
+        &reachability_labels_model) {
+  if (reachability_labels_model.components_size() !=
+      reachability_labels_model.weak_components_size()) {
+    throw std::runtime_error("reachability labels are malformed");
+  }
+
+  std::vector<graph::ReachabilityLabels::Label> labels;
+  labels.reserve(reachability_labels_model.components_size());
+  for (int i = 0; i < reachability_labels_model.components_size(); ++i) {
+    labels.push_back({reachability_labels_model.components(i),
+                      reachability_labels_model.weak_components(i)});
+  }
+
+  return graph::ReachabilityLabels(std::move(labels));
+}
+
+transport_catalogue_model::TransportRouter TransportRouterSerialization(
+    const transport_catalogue::TransportCatalogue &transport_catalogue,
+    const transport_catalogue::router::TransportRouter &transport_router) {
+  transport_catalogue_model::TransportRouter transport_router_model;
+
+  const auto &stops = transport_catalogue.GetStops();
+  const auto &buses = transport_catalogue.GetBuses();
+
+  std::unordered_map<std::string_view, uint32_t> stop_ids;
+  for (const auto &stop : stops) {
+    stop_ids.emplace(stop.name, stop_ids.size());
+  }
+
+  std::unordered_map<std::string_view, uint32_t> bus_ids;
+  for (const auto &bus : buses) {
+    bus_ids.emplace(bus.name, bus_ids.size());
+  }
+
+  const auto &graph = transport_router.GetGraph();
+  *transport_router_model.mutable_graph() = GraphSerialization(graph);
+
+  for (graph::EdgeId id = 0; id < graph.GetEdgeCount(); ++id) {
+    transport_catalogue_model::EdgeInfo edge_model;
+    const auto &edge = transport_router.GetEdge(id);
+
+    if (std::holds_alternative<domain::StopEdge>(edge)) {
+      edge_model.mutable_stop_edge()->set_stop_id(
+          stop_ids.at(std::get<domain::StopEdge>(edge).name));
+
+    } else {
+      const auto &bus_edge = std::get<domain::BusEdge>(edge);
+
+      edge_model.mutable_bus_edge()->set_bus_id(bus_ids.at(bus_edge.name));
+      edge_model.mutable_bus_edge()->set_span_count(bus_edge.span_count);
+    }
+
+    *transport_router_model.add_edges() = std::move(edge_model);
+  }
+
+  for (const auto &[stop, router_stop] : transport_router.GetStopVertex()) {
+    transport_catalogue_model::RouterStop router_stop_model;
+
+    router_stop_model.set_stop_id(stop_ids.at(stop->name));
+    router_stop_model.set_bus_wait_start(router_stop.bus_wait_start);
+    router_stop_model.set_bus_wait_end(router_stop.bus_wait_end);
+
+    *transport_router_model.add_stops() = std::move(router_stop_model);
+  }
+
+  for (const domain::Stop *stop : transport_router.GetVertexStops()) {
+    transport_router_model.add_vertex_stops(stop ? stop_ids.at(stop->name) + 1
+                                                 : 0);
+  }
+
+  *transport_router_model.mutable_reachability_labels() =
+      ReachabilityLabelsSerialization(
+          transport_router.GetReachabilityLabels());
+
+  switch (transport_router.GetRoutingSettings().router_type) {
+    case domain::RouterType::DIJKSTRA:
+    case domain::RouterType::ASTAR:
+      break;
+    case domain::RouterType::ALL_PAIRS:
+      *transport_router_model.mutable_routes_internal_data() =
+          RoutesInternalDataSerialization(
+              transport_router.GetRouter().GetRoutesInternalData());
+      break;
+    case domain::RouterType::CONTRACTION_HIERARCHIES:
+      *transport_router_model.mutable_contraction_hierarchy() =
+          ContractionHierarchySerialization(
+              transport_router.GetContractionHierarchy());
+      break;
+    case domain::RouterType::HUB_LABELS:
+      *transport_router_model.mutable_hub_labels() = HubLabelsSerialization(
+          transport_router.GetHubLabels().GetHubLabelsData());
+      break;
+    case domain::RouterType::ALT:
+      *transport_router_model.mutable_landmarks() = LandmarksSerialization(
+          transport_router.GetLandmarks().GetLandmarksData());
+      break;
+  }
+
+  return transport_router_model;
+}
+
+transport_catalogue::router::TransportRouter TransportRouterDeserialization(
+    const transport_catalogue_model::TransportRouter &transport_router_model,
+    const domain::RoutingSettings &routing_settings,
+    transport_catalogue::TransportCatalogue &transport_catalogue) {
+  transport_catalogue::router::TransportRouter transport_router;
+
+  std::vector<domain::Stop *> stops;
+  for (const auto &stop : transport_catalogue.GetStops()) {
+    stops.push_back(transport_catalogue.GetStop(stop.name));
+  }
+
+  std::vector<domain::Bus *> buses;
+  for (const auto &bus : transport_catalogue.GetBuses()) {
+    buses.push_back(transport_catalogue.GetBus(bus.name));
+  }
+
+  transport_router.SetRoutingSettings(routing_settings);
+  transport_router.SetGraph(
+      GraphDeserialization(transport_router_model.graph()));
+
+  const auto &graph = transport_router.GetGraph();
+  graph::EdgeId id = 0;
+
+  for (const auto &edge_model : transport_router_model.edges()) {
+    if (edge_model.has_stop_edge()) {
+      transport_router.SetEdge(
+          id, domain::StopEdge{stops.at(edge_model.stop_edge().stop_id())->name,
+                               routing_settings.bus_wait_time});
+    } else {
+      transport_router.SetEdge(
+          id, domain::BusEdge{buses.at(edge_model.bus_edge().bus_id())->name,
+                              edge_model.bus_edge().span_count(),
+                              graph.GetEdge(id).weight});
+    }
+
+    ++id;
+  }
+
+  for (const auto &router_stop_model : transport_router_model.stops()) {
+    transport_router.SetRouterStop(stops.at(router_stop_model.stop_id()),
+                                   {router_stop_model.bus_wait_start(),
+                                    router_stop_model.bus_wait_end()});
+  }
+
+  if (static_cast<size_t>(transport_router_model.vertex_stops_size()) >
+      graph.GetVertexCount()) {
+    throw std::runtime_error("vertex stops do not match the graph");
+  }
+  graph::VertexId vertex = 0;
+  for (const uint32_t stop_id : transport_router_model.vertex_stops()) {
+    if (stop_id > 0) {
+      transport_router.SetVertexStop(vertex, stops.at(stop_id - 1));
+    }
+    ++vertex;
+  }
+
+  // Labels are built with the router when the database has none.
+  if (transport_router_model.has_reachability_labels()) {
+    auto reachability_labels = ReachabilityLabelsDeserialization(
+        transport_router_model.reachability_labels());
+
+    if (reachability_labels.GetLabels().size() != graph.GetVertexCount()) {
+      throw std::runtime_error("reachability labels do not match the graph");
+    }
+    transport_router.SetReachabilityLabels(std::move(reachability_labels));
+  }
+
+  if (routing_settings.router_type == domain::RouterType::ALL_PAIRS &&
+      transport_router_model.has_routes_internal_data()) {
+    transport_router.BuildRouter(RoutesInternalDataDeserialization(
+        transport_router_model.routes_internal_data(),
+        graph.GetVertexCount()));
+  } else if (routing_settings.router_type ==
+                 domain::RouterType::CONTRACTION_HIERARCHIES &&
+             transport_router_model.has_contraction_hierarchy()) {
+    transport_router.BuildRouter(ContractionHierarchyDeserialization(
+        transport_router_model.contraction_hierarchy()));
+  } else if (routing_settings.router_type == domain::RouterType::HUB_LABELS &&
+             transport_router_model.has_hub_labels()) {
+    const graph::VertexId vertex_count = graph.GetVertexCount();
+    auto hub_labels_data =
+        HubLabelsDeserialization(transport_router_model.hub_labels());
+
+    if (hub_labels_data.hubs.size() != vertex_count ||
+        hub_labels_data.out_labels.offsets.size() != vertex_count + 1 ||
+        hub_labels_data.in_labels.offsets.size() != vertex_count + 1) {
+      throw std::runtime_error("hub labels do not match the graph");
+    }
+    transport_router.BuildRouter(std::move(hub_labels_data));
+  } else if (routing_settings.router_type == domain::RouterType::ALT &&
+             transport_router_model.has_landmarks()) {
+    auto landmarks_data =
+        LandmarksDeserialization(transport_router_model.landmarks());
+    const size_t weight_count =
+        graph.GetVertexCount() * landmarks_data.landmarks.size();
+
+    if (landmarks_data.weights_from.size() != weight_count ||
+        landmarks_data.weights_to.size() != weight_count) {
+      throw std::runtime_error("landmarks do not match the graph");
+    }
+    transport_router.BuildRouter(std::move(landmarks_data));
+  } else {
+    transport_router.BuildRouter();
+  }
+
+  return transport_router;
+}
+
 void CatalogueSerialization(
     const transport_catalogue::TransportCatalogue &transport_catalogue,
     const renderer::RenderSettings &render_settings,
-    const domain::RoutingSettings &routing_settings, std::ostream &out) {
+    const transport_catalogue::router::TransportRouter &transport_router, std::ostream &out) {
   transport_catalogue_model::Catalogue catalogue_model;
 
   transport_catalogue_model::TransportCatalogue transport_catalogue_model =
@@ -288,13 +791,17 @@ void CatalogueSerialization(
   transport_catalogue_model::RenderSettings render_settings_model =
       RenderSettingsSerialization(render_settings);
   transport_catalogue_model::RoutingSettings routing_settings_model =
-      RoutingSettingsSerialization(routing_settings);
+      RoutingSettingsSerialization(transport_router.GetRoutingSettings());
+  transport_catalogue_model::TransportRouter transport_router_model =
+      TransportRouterSerialization(transport_catalogue, transport_router);
 
   *catalogue_model.mutable_transport_catalogue() =
       std::move(transport_catalogue_model);
   *catalogue_model.mutable_render_settings() = std::move(render_settings_model);
   *catalogue_model.mutable_routing_settings() =
       std::move(routing_settings_model);
+  *catalogue_model.mutable_transport_router() =
+      std::move(transport_router_model);
 
   catalogue_model.SerializePartialToOstream(&out);
 }
@@ -306,10 +813,33 @@ Catalogue CatalogueDeserialization(std::istream &in) {
     throw std::runtime_error("cannot parse serialized file from istream");
   }
 
-  return {
+  Catalogue catalogue{
       TransportCatalogueDeserialization(catalogue_model.transport_catalogue()),
       RenderSettingsDeserialization(catalogue_model.render_settings()),
-      RoutingSettingsDeserialization(catalogue_model.routing_settings())};
+      RoutingSettingsDeserialization(catalogue_model.routing_settings()),
+      {}};
+
+  if (catalogue_model.has_transport_router()) {
+    catalogue.transport_router_model_ =
+        std::move(*catalogue_model.mutable_transport_router());
+  }
+
+  return catalogue;
+}
+
+transport_catalogue::router::TransportRouter TransportRouterDeserialization(
+    Catalogue &catalogue) {
+  if (catalogue.transport_router_model_) {
+    return TransportRouterDeserialization(*catalogue.transport_router_model_,
+                                          catalogue.routing_settings_,
+                                          catalogue.transport_catalogue_);
+  }
+
+  transport_catalogue::router::TransportRouter transport_router;
+  transport_router.SetRoutingSettings(catalogue.routing_settings_);
+  transport_router.BuildRouter(catalogue.transport_catalogue_);
+
+  return transport_router;
 }
 
 }  // end namespace serialization
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <iostream>
+#include <limits>
+#include <optional>
 
 #include "catalogue.h"
 #include "catalogue.pb.h"
@@ -20,6 +22,8 @@ struct Catalogue {
   transport_catalogue::TransportCatalogue transport_catalogue_;
   renderer::RenderSettings render_settings_;
   domain::RoutingSettings routing_settings_;
+  std::optional<transport_catalogue_model::TransportRouter>
+      transport_router_model_;
 };
 
 template <typename It>
@@ -44,10 +48,61 @@ transport_catalogue_model::RoutingSettings RoutingSettingsSerialization(
 domain::RoutingSettings RoutingSettingsDeserialization(
     const transport_catalogue_model::RoutingSettings &routing_settings_proto);
 
+transport_catalogue_model::Graph GraphSerialization(
+    const graph::DirectedWeightedGraph<double> &graph);
+graph::DirectedWeightedGraph<double> GraphDeserialization(
+    const transport_catalogue_model::Graph &graph_model);
+
+transport_catalogue_model::RoutesInternalData RoutesInternalDataSerialization(
+    const graph::Router<double>::RoutesInternalData &routes_internal_data);
+graph::Router<double>::RoutesInternalData RoutesInternalDataDeserialization(
+    const transport_catalogue_model::RoutesInternalData
+        &routes_internal_data_model,
+    size_t vertex_count);
+
+transport_catalogue_model::ContractionHierarchy
+ContractionHierarchySerialization(
+    const graph::ContractionHierarchy<double> &contraction_hierarchy);
+graph::ContractionHierarchy<double> ContractionHierarchyDeserialization(
+    const transport_catalogue_model::ContractionHierarchy
+        &contraction_hierarchy_model);
+
+transport_catalogue_model::Labels LabelsSerialization(
+    const graph::HubLabels<double>::Labels &labels);
+graph::HubLabels<double>::Labels LabelsDeserialization(
+    const transport_catalogue_model::Labels &labels_model);
+transport_catalogue_model::HubLabels HubLabelsSerialization(
+    const graph::HubLabels<double>::HubLabelsData &hub_labels_data);
+graph::HubLabels<double>::HubLabelsData HubLabelsDeserialization(
+    const transport_catalogue_model::HubLabels &hub_labels_model);
+
+transport_catalogue_model::Landmarks LandmarksSerialization(
+    const graph::Landmarks<transport_catalogue::router::SearchTime>::
+        LandmarksData &landmarks_data);
+graph::Landmarks<transport_catalogue::router::SearchTime>::LandmarksData
+LandmarksDeserialization(
+    const transport_catalogue_model::Landmarks &landmarks_model);
+
+transport_catalogue_model::ReachabilityLabels ReachabilityLabelsSerialization(
+    const graph::ReachabilityLabels &reachability_labels);
+graph::ReachabilityLabels ReachabilityLabelsDeserialization(
+    const transport_catalogue_model::ReachabilityLabels
+        &reachability_labels_model);
+
+transport_catalogue_model::TransportRouter TransportRouterSerialization(
+    const transport_catalogue::TransportCatalogue &transport_catalogue,
+    const transport_catalogue::router::TransportRouter &transport_router);
+transport_catalogue::router::TransportRouter TransportRouterDeserialization(
+    const transport_catalogue_model::TransportRouter &transport_router_model,
+    const domain::RoutingSettings &routing_settings,
+    transport_catalogue::TransportCatalogue &transport_catalogue);
+transport_catalogue::router::TransportRouter TransportRouterDeserialization(
+    Catalogue &catalogue);
+
 void CatalogueSerialization(
     const transport_catalogue::TransportCatalogue &transport_catalogue,
     const renderer::RenderSettings &render_settings,
-    const domain::RoutingSettings &routing_settings, std::ostream &out);
+    const transport_catalogue::router::TransportRouter &transport_router, std::ostream &out);
 
 Catalogue CatalogueDeserialization(std::istream &in);
 